@@ -15,6 +15,8 @@
 #include <list>
 #include <unordered_map>
 
+#include "storage/page/page_guard.h"
+
 namespace bustub {
 
 BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, LogManager *log_manager)
@@ -74,4 +76,10 @@ void BufferPoolManager::FlushAllPagesImpl() {
   // You can do it!
 }
 
+ReadPageGuard BufferPoolManager::FetchPageRead(page_id_t page_id) { return ReadPageGuard(this, FetchPage(page_id)); }
+
+WritePageGuard BufferPoolManager::FetchPageWrite(page_id_t page_id) { return WritePageGuard(this, FetchPage(page_id)); }
+
+WritePageGuard BufferPoolManager::NewPageGuarded(page_id_t *page_id) { return WritePageGuard(this, NewPage(page_id)); }
+
 }  // namespace bustub
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// thread_pool.cpp
+//
+// Identification: src/common/thread_pool.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace bustub {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; i++) {
+    threads_.emplace_back(&ThreadPool::Work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock latch(latch_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  {
+    std::scoped_lock latch(latch_);
+    num_busy_++;
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+size_t ThreadPool::TryReserve(size_t num_threads) {
+  std::scoped_lock latch(latch_);
+  size_t num_idle = num_busy_ < threads_.size() ? threads_.size() - num_busy_ : 0;
+  size_t num_reserved = std::min(num_threads, num_idle);
+  num_busy_ += num_reserved;
+  return num_reserved;
+}
+
+void ThreadPool::SubmitReserved(std::function<void()> task) {
+  {
+    std::scoped_lock latch(latch_);
+    // The task was counted as busy when its thread was reserved.
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void ThreadPool::Work() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock latch(latch_);
+      cv_.wait(latch, [this] { return shutdown_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+    std::scoped_lock latch(latch_);
+    num_busy_--;
+  }
+}
+
+}  // namespace bustub
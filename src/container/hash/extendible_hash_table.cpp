@@ -0,0 +1,329 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table.cpp
+//
+// Identification: src/container/hash/extendible_hash_table.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/rid.h"
+#include "container/hash/extendible_hash_table.h"
+
+namespace bustub {
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+EXTENDIBLE_HASH_TABLE_TYPE::ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                                const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  // Create the directory with global depth 0, i.e. a single slot pointing at a single empty bucket.
+  WritePageGuard dir_guard = buffer_pool_manager_->NewPageGuarded(&directory_page_id_);
+  if (!dir_guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't create a directory page for the hash table.");
+  }
+  auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+  dir_page->SetPageId(directory_page_id_);
+
+  page_id_t bucket_page_id = INVALID_PAGE_ID;
+  WritePageGuard bucket_guard = buffer_pool_manager_->NewPageGuarded(&bucket_page_id);
+  if (!bucket_guard.IsValid()) {
+    dir_guard.Drop();
+    buffer_pool_manager_->DeletePage(directory_page_id_);
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't create a bucket page for the hash table.");
+  }
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+
+  bucket_guard.MarkDirty();
+  dir_guard.MarkDirty();
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::Hash(KeyType key) {
+  return static_cast<uint32_t>(hash_fn_.GetHash(key));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, const HashTableDirectoryPage *dir_page) {
+  return Hash(key) & dir_page->GetGlobalDepthMask();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ReadPageGuard EXTENDIBLE_HASH_TABLE_TYPE::FetchDirectoryPageRead() {
+  ReadPageGuard guard = buffer_pool_manager_->FetchPageRead(directory_page_id_);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch the hash table directory page.");
+  }
+  return guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+WritePageGuard EXTENDIBLE_HASH_TABLE_TYPE::FetchDirectoryPageWrite() {
+  WritePageGuard guard = buffer_pool_manager_->FetchPageWrite(directory_page_id_);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch the hash table directory page.");
+  }
+  return guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ReadPageGuard EXTENDIBLE_HASH_TABLE_TYPE::FetchBucketPageRead(page_id_t bucket_page_id) {
+  ReadPageGuard guard = buffer_pool_manager_->FetchPageRead(bucket_page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch a hash table bucket page.");
+  }
+  return guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+WritePageGuard EXTENDIBLE_HASH_TABLE_TYPE::FetchBucketPageWrite(page_id_t bucket_page_id) {
+  WritePageGuard guard = buffer_pool_manager_->FetchPageWrite(bucket_page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch a hash table bucket page.");
+  }
+  return guard;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                          std::vector<ValueType> *result) {
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard dir_guard = FetchDirectoryPageRead();
+  auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+  ReadPageGuard bucket_guard = FetchBucketPageRead(dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page)));
+  return bucket_guard.As<HASH_TABLE_BUCKET_TYPE>()->GetValue(key, comparator_, result);
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  {
+    ReadLatchGuard table_guard(&table_latch_);
+    ReadPageGuard dir_guard = FetchDirectoryPageRead();
+    auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+    WritePageGuard bucket_guard = FetchBucketPageWrite(dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page)));
+    auto bucket = bucket_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    if (!bucket->IsFull()) {
+      // Fast path: the bucket has room, so only the bucket page latch is held exclusively.
+      bool inserted = bucket->Insert(key, value, comparator_);
+      if (inserted) {
+        bucket_guard.MarkDirty();
+      }
+      return inserted;
+    }
+  }
+
+  return SplitInsert(transaction, key, value);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  WriteLatchGuard table_guard(&table_latch_);
+  WritePageGuard dir_guard = FetchDirectoryPageWrite();
+  auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+  uint32_t key_hash = Hash(key);
+
+  while (true) {
+    uint32_t bucket_idx = key_hash & dir_page->GetGlobalDepthMask();
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    WritePageGuard bucket_guard = FetchBucketPageWrite(bucket_page_id);
+    auto bucket = bucket_guard.As<HASH_TABLE_BUCKET_TYPE>();
+
+    // Another writer may have made room since we dropped the read latch.
+    if (!bucket->IsFull()) {
+      bool inserted = bucket->Insert(key, value, comparator_);
+      if (inserted) {
+        bucket_guard.MarkDirty();
+      }
+      return inserted;
+    }
+
+    // Do not split on behalf of a duplicate (key, value) pair.
+    std::vector<ValueType> existing;
+    bucket->GetValue(key, comparator_, &existing);
+    for (const auto &v : existing) {
+      if (v == value) {
+        return false;
+      }
+    }
+
+    // Splitting separates entries by hash, so it cannot make room if every entry has the new key's hash. Check
+    // before touching the directory, so that a failed insert leaves the table as it was.
+    bool same_hash = true;
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE && same_hash; slot++) {
+      same_hash = !bucket->IsReadable(slot) || Hash(bucket->KeyAt(slot)) == key_hash;
+    }
+    if (same_hash) {
+      throw Exception(ExceptionType::OUT_OF_RANGE,
+                      "Extendible hash table bucket is full of keys with the same hash and cannot be split.");
+    }
+
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    bool grow = local_depth == dir_page->GetGlobalDepth();
+    if (grow && dir_page->Size() * 2 > HashTableDirectoryPage::MaxSize()) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "Extendible hash table directory is full and cannot be split.");
+    }
+
+    // Split the bucket: slots whose hash has the new high bit set now point at a fresh image page.
+    page_id_t image_page_id = INVALID_PAGE_ID;
+    WritePageGuard image_guard = buffer_pool_manager_->NewPageGuarded(&image_page_id);
+    if (!image_guard.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't create a bucket page for the hash table.");
+    }
+    if (grow) {
+      dir_page->IncrGlobalDepth();
+    }
+    auto image = image_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    uint32_t high_bit = dir_page->GetLocalHighBit(bucket_idx);
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      if (dir_page->GetBucketPageId(i) == bucket_page_id) {
+        dir_page->IncrLocalDepth(i);
+        if ((i & high_bit) != 0) {
+          dir_page->SetBucketPageId(i, image_page_id);
+        }
+      }
+    }
+    dir_guard.MarkDirty();
+
+    // Move the entries that now belong to the image. Only this one bucket is rehashed, and no other bucket latches
+    // are needed because the table latch is held exclusively.
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE; slot++) {
+      if (bucket->IsReadable(slot)) {
+        KeyType slot_key = bucket->KeyAt(slot);
+        if ((Hash(slot_key) & high_bit) != 0) {
+          image->Insert(slot_key, bucket->ValueAt(slot), comparator_);
+          bucket->RemoveAt(slot);
+        }
+      }
+    }
+    image_guard.MarkDirty();
+    bucket_guard.MarkDirty();
+  }
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  bool removed;
+  bool empty;
+  {
+    ReadLatchGuard table_guard(&table_latch_);
+    ReadPageGuard dir_guard = FetchDirectoryPageRead();
+    auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+    WritePageGuard bucket_guard = FetchBucketPageWrite(dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page)));
+    auto bucket = bucket_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    removed = bucket->Remove(key, value, comparator_);
+    empty = bucket->IsEmpty();
+    if (removed) {
+      bucket_guard.MarkDirty();
+    }
+  }
+
+  if (removed && empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
+}
+
+/*****************************************************************************
+ * MERGE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void EXTENDIBLE_HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  WriteLatchGuard table_guard(&table_latch_);
+  WritePageGuard dir_guard = FetchDirectoryPageWrite();
+  auto dir_page = dir_guard.As<HashTableDirectoryPage>();
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+
+  // Keep folding while either half of the pair is empty. This also picks up a sibling that emptied earlier but
+  // could not merge at the time because its split image was still split deeper.
+  while (true) {
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    if (local_depth == 0 || dir_page->GetLocalDepth(image_idx) != local_depth || bucket_page_id == image_page_id) {
+      break;
+    }
+
+    bool bucket_empty;
+    {
+      ReadPageGuard bucket_guard = FetchBucketPageRead(bucket_page_id);
+      bucket_empty = bucket_guard.As<HASH_TABLE_BUCKET_TYPE>()->IsEmpty();
+    }
+    bool image_empty = false;
+    if (!bucket_empty) {
+      ReadPageGuard image_guard = FetchBucketPageRead(image_page_id);
+      image_empty = image_guard.As<HASH_TABLE_BUCKET_TYPE>()->IsEmpty();
+    }
+    if (!bucket_empty && !image_empty) {
+      break;
+    }
+
+    page_id_t keep_page_id = bucket_empty ? image_page_id : bucket_page_id;
+    page_id_t drop_page_id = bucket_empty ? bucket_page_id : image_page_id;
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      page_id_t page_id = dir_page->GetBucketPageId(i);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(i, keep_page_id);
+        dir_page->DecrLocalDepth(i);
+      }
+    }
+    buffer_pool_manager_->DeletePage(drop_page_id);
+    dir_guard.MarkDirty();
+  }
+
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+    dir_guard.MarkDirty();
+  }
+}
+
+/*****************************************************************************
+ * GETGLOBALDEPTH
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::GetGlobalDepth() {
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard dir_guard = FetchDirectoryPageRead();
+  return dir_guard.As<HashTableDirectoryPage>()->GetGlobalDepth();
+}
+
+/*****************************************************************************
+ * VERIFY INTEGRITY
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void EXTENDIBLE_HASH_TABLE_TYPE::VerifyIntegrity() {
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard dir_guard = FetchDirectoryPageRead();
+  dir_guard.As<HashTableDirectoryPage>()->VerifyIntegrity();
+}
+
+template class ExtendibleHashTable<int, int, IntComparator>;
+
+template class ExtendibleHashTable<GenericKey<4>, RID, GenericComparator<4>>;
+template class ExtendibleHashTable<GenericKey<8>, RID, GenericComparator<8>>;
+template class ExtendibleHashTable<GenericKey<16>, RID, GenericComparator<16>>;
+template class ExtendibleHashTable<GenericKey<32>, RID, GenericComparator<32>>;
+template class ExtendibleHashTable<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -10,8 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -26,21 +28,221 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                       const KeyComparator &comparator, size_t num_buckets,
                                       HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  header_page_id_ = CreateTable(num_buckets);
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t HASH_TABLE_TYPE::CreateTable(size_t num_buckets) {
+  size_t num_blocks = std::max<size_t>(1, (num_buckets + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE);
+
+  page_id_t header_page_id = INVALID_PAGE_ID;
+  WritePageGuard header_guard = buffer_pool_manager_->NewPageGuarded(&header_page_id);
+  if (!header_guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't create a header page for the hash table.");
+  }
+  auto header = header_guard.As<HashTableHeaderPage>();
+  if (num_blocks > header->MaxNumBlocks()) {
+    header_guard.Drop();
+    buffer_pool_manager_->DeletePage(header_page_id);
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Hash table needs more blocks than fit in its header page.");
+  }
+  header->SetPageId(header_page_id);
+  header->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  header_guard.MarkDirty();
+
+  for (size_t i = 0; i < num_blocks; i++) {
+    page_id_t block_page_id = INVALID_PAGE_ID;
+    WritePageGuard block_guard = buffer_pool_manager_->NewPageGuarded(&block_page_id);
+    if (!block_guard.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't create a block page for the hash table.");
+    }
+    block_guard.MarkDirty();
+    header->AddBlockPageId(block_page_id);
+  }
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ReadPageGuard HASH_TABLE_TYPE::FetchHeaderPage(page_id_t header_page_id) {
+  ReadPageGuard guard = buffer_pool_manager_->FetchPageRead(header_page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch the hash table header page.");
+  }
+  return guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ReadPageGuard HASH_TABLE_TYPE::FetchBlockPageRead(page_id_t block_page_id) {
+  ReadPageGuard guard = buffer_pool_manager_->FetchPageRead(block_page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch a hash table block page.");
+  }
+  return guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+WritePageGuard HASH_TABLE_TYPE::FetchBlockPageWrite(page_id_t block_page_id) {
+  WritePageGuard guard = buffer_pool_manager_->FetchPageWrite(block_page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Couldn't fetch a hash table block page.");
+  }
+  return guard;
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) {
-  return false;
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard header_guard = FetchHeaderPage(header_page_id_);
+  auto header = header_guard.As<HashTableHeaderPage>();
+  size_t num_groups = header->GetSize() / BLOCK_GROUP_SIZE;
+  uint64_t hash = hash_fn_.GetHash(key);
+  size_t start = hash % num_groups;
+  uint8_t fingerprint = HASH_TABLE_BLOCK_TYPE::FingerprintOf(hash);
+
+  bool found = false;
+  bool done = false;
+  for (size_t probed = 0; probed < num_groups && !done;) {
+    size_t slot = (start + probed) % num_groups * BLOCK_GROUP_SIZE;
+    ReadPageGuard block_guard = FetchBlockPageRead(header->GetBlockPageId(slot / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+
+    for (slot_offset_t group = slot % BLOCK_ARRAY_SIZE; group < BLOCK_ARRAY_SIZE && probed < num_groups;
+         group += BLOCK_GROUP_SIZE, probed++) {
+      for (uint32_t match = block->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+        slot_offset_t offset = group + __builtin_ctz(match);
+        if (comparator_(key, block->KeyAt(offset)) == 0) {
+          result->push_back(block->ValueAt(offset));
+          found = true;
+        }
+      }
+      if (block->MatchEmpty(group) != 0) {
+        done = true;
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                                std::vector<std::vector<ValueType>> *results) {
+  results->assign(keys.size(), std::vector<ValueType>());
+  if (keys.empty()) {
+    return;
+  }
+
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard header_guard = FetchHeaderPage(header_page_id_);
+  auto header = header_guard.As<HashTableHeaderPage>();
+  size_t num_groups = header->GetSize() / BLOCK_GROUP_SIZE;
+
+  // (start group, hash, key index), probed in slot order so that neighbouring probes reuse the latched block
+  std::vector<std::tuple<size_t, uint64_t, size_t>> probes;
+  probes.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    uint64_t hash = hash_fn_.GetHash(keys[i]);
+    probes.emplace_back(hash % num_groups, hash, i);
+  }
+  std::sort(probes.begin(), probes.end());
+
+  ReadPageGuard block_guard;
+  for (const auto &[start, hash, key_idx] : probes) {
+    uint8_t fingerprint = HASH_TABLE_BLOCK_TYPE::FingerprintOf(hash);
+    for (size_t probed = 0; probed < num_groups; probed++) {
+      size_t slot = (start + probed) % num_groups * BLOCK_GROUP_SIZE;
+      page_id_t block_page_id = header->GetBlockPageId(slot / BLOCK_ARRAY_SIZE);
+      if (!block_guard.IsValid() || block_guard.PageId() != block_page_id) {
+        block_guard.Drop();
+        block_guard = FetchBlockPageRead(block_page_id);
+      }
+
+      auto block = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+      slot_offset_t group = slot % BLOCK_ARRAY_SIZE;
+      for (uint32_t match = block->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+        slot_offset_t offset = group + __builtin_ctz(match);
+        if (comparator_(keys[key_idx], block->KeyAt(offset)) == 0) {
+          (*results)[key_idx].push_back(block->ValueAt(offset));
+        }
+      }
+      if (block->MatchEmpty(group) != 0) {
+        break;
+      }
+    }
+  }
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+  size_t size;
+  bool table_full = false;
+  bool inserted;
+  {
+    ReadLatchGuard table_guard(&table_latch_);
+    ReadPageGuard header_guard = FetchHeaderPage(header_page_id_);
+    auto header = header_guard.As<HashTableHeaderPage>();
+    size = header->GetSize();
+    inserted = InsertIntoTable(header, key, value, &table_full);
+  }
+
+  if (table_full) {
+    Resize(size);
+    return Insert(transaction, key, value);
+  }
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::InsertIntoTable(const HashTableHeaderPage *header, const KeyType &key, const ValueType &value,
+                                      bool *table_full) {
+  size_t num_groups = header->GetSize() / BLOCK_GROUP_SIZE;
+  uint64_t hash = hash_fn_.GetHash(key);
+  size_t start = hash % num_groups;
+  uint8_t fingerprint = HASH_TABLE_BLOCK_TYPE::FingerprintOf(hash);
+
+  bool inserted = false;
+  bool done = false;
+  for (size_t probed = 0; probed < num_groups && !done;) {
+    size_t slot = (start + probed) % num_groups * BLOCK_GROUP_SIZE;
+    WritePageGuard block_guard = FetchBlockPageWrite(header->GetBlockPageId(slot / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+
+    for (slot_offset_t group = slot % BLOCK_ARRAY_SIZE; group < BLOCK_ARRAY_SIZE && probed < num_groups;
+         group += BLOCK_GROUP_SIZE, probed++) {
+      for (uint32_t match = block->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+        slot_offset_t offset = group + __builtin_ctz(match);
+        if (comparator_(key, block->KeyAt(offset)) == 0 && value == block->ValueAt(offset)) {
+          done = true;
+          break;
+        }
+      }
+      if (done) {
+        break;
+      }
+      uint32_t empty = block->MatchEmpty(group);
+      if (empty != 0) {
+        inserted = block->Insert(group + __builtin_ctz(empty), key, value, fingerprint);
+        done = true;
+        break;
+      }
+    }
+    if (inserted) {
+      block_guard.MarkDirty();
+    }
+  }
+
+  *table_full = !done;
+  return inserted;
 }
 
 /*****************************************************************************
@@ -48,21 +250,89 @@ bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard header_guard = FetchHeaderPage(header_page_id_);
+  auto header = header_guard.As<HashTableHeaderPage>();
+  size_t num_groups = header->GetSize() / BLOCK_GROUP_SIZE;
+  uint64_t hash = hash_fn_.GetHash(key);
+  size_t start = hash % num_groups;
+  uint8_t fingerprint = HASH_TABLE_BLOCK_TYPE::FingerprintOf(hash);
+
+  bool removed = false;
+  bool done = false;
+  for (size_t probed = 0; probed < num_groups && !done;) {
+    size_t slot = (start + probed) % num_groups * BLOCK_GROUP_SIZE;
+    WritePageGuard block_guard = FetchBlockPageWrite(header->GetBlockPageId(slot / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+
+    for (slot_offset_t group = slot % BLOCK_ARRAY_SIZE; group < BLOCK_ARRAY_SIZE && probed < num_groups;
+         group += BLOCK_GROUP_SIZE, probed++) {
+      for (uint32_t match = block->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+        slot_offset_t offset = group + __builtin_ctz(match);
+        if (comparator_(key, block->KeyAt(offset)) == 0 && value == block->ValueAt(offset)) {
+          block->Remove(offset);
+          block_guard.MarkDirty();
+          removed = true;
+          break;
+        }
+      }
+      if (removed || block->MatchEmpty(group) != 0) {
+        done = true;
+        break;
+      }
+    }
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  WriteLatchGuard table_guard(&table_latch_);
+  ReadPageGuard old_header_guard = FetchHeaderPage(header_page_id_);
+  auto old_header = old_header_guard.As<HashTableHeaderPage>();
+  size_t new_size = 2 * initial_size;
+  if (old_header->GetSize() >= new_size) {
+    // Another inserter already grew the table while we waited for the latch.
+    return;
+  }
+
+  page_id_t new_header_page_id = CreateTable(new_size);
+  ReadPageGuard new_header_guard = FetchHeaderPage(new_header_page_id);
+  auto new_header = new_header_guard.As<HashTableHeaderPage>();
+
+  // Rehash every live pair; tombstones are left behind with the old blocks.
+  for (size_t i = 0; i < old_header->NumBlocks(); i++) {
+    page_id_t block_page_id = old_header->GetBlockPageId(i);
+    {
+      ReadPageGuard block_guard = FetchBlockPageRead(block_page_id);
+      auto block = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+      for (slot_offset_t offset = 0; offset < BLOCK_ARRAY_SIZE; offset++) {
+        if (block->IsReadable(offset)) {
+          bool table_full = false;
+          InsertIntoTable(new_header, block->KeyAt(offset), block->ValueAt(offset), &table_full);
+          BUSTUB_ASSERT(!table_full, "resized hash table cannot be full");
+        }
+      }
+    }
+    buffer_pool_manager_->DeletePage(block_page_id);
+  }
+
+  old_header_guard.Drop();
+  buffer_pool_manager_->DeletePage(header_page_id_);
+  header_page_id_ = new_header_page_id;
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 size_t HASH_TABLE_TYPE::GetSize() {
-  return 0;
+  ReadLatchGuard table_guard(&table_latch_);
+  ReadPageGuard header_guard = FetchHeaderPage(header_page_id_);
+  return header_guard.As<HashTableHeaderPage>()->GetSize();
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
@@ -1,29 +1,271 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-19, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
-
-void AggregationExecutor::Init() {}
-
-bool AggregationExecutor::Next(Tuple *tuple, RID *rid) { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "execution/executors/aggregation_executor.h"
+
+namespace bustub {
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)), aht_(MakeTable()) {}
+
+const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
+
+AggregationHashTable AggregationExecutor::MakeTable() const {
+  std::vector<TypeId> key_types;
+  for (const auto &expr : plan_->GetGroupBys()) {
+    key_types.push_back(expr->GetReturnType());
+  }
+  return AggregationHashTable(std::move(key_types), plan_->GetAggregateTypes());
+}
+
+hash_t AggregationExecutor::MakeKey(const Tuple *tuple) {
+  key_.clear();
+  for (const auto &expr : plan_->GetGroupBys()) {
+    AggregationHashTable::AppendKey(expr->Evaluate(tuple, child_->GetOutputSchema()), &key_);
+  }
+  return AggregationHashTable::HashKey(key_);
+}
+
+void AggregationExecutor::MakeVal(const Tuple *tuple) {
+  input_.clear();
+  for (const auto &expr : plan_->GetAggregates()) {
+    input_.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+  }
+}
+
+std::vector<std::unique_ptr<TmpTupleFile>> AggregationExecutor::MakePartitions() {
+  std::vector<std::unique_ptr<TmpTupleFile>> partitions;
+  partitions.reserve(NUM_PARTITIONS);
+  for (uint32_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions.push_back(std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager()));
+  }
+  return partitions;
+}
+
+void AggregationExecutor::SpillGroup(const AggregationHashTable &table, size_t group, TmpTupleFile *file) {
+  std::vector<Tuple> records = table.SpillGroup(group);
+  // A record is never split over pages, and there is nowhere else for the group to go, so the query fails.
+  for (const auto &record : records) {
+    if (record.GetLength() > TmpTuplePage::MaxTupleSize()) {
+      throw Exception(ExceptionType::OUT_OF_RANGE,
+                      "An aggregation group is too large to spill: one of its records takes " +
+                          std::to_string(record.GetLength()) + " bytes, but a temporary page holds at most " +
+                          std::to_string(TmpTuplePage::MaxTupleSize()) + ".");
+    }
+  }
+  for (const auto &record : records) {
+    file->Append(record);
+  }
+}
+
+void AggregationExecutor::SpillTable(AggregationHashTable *table,
+                                     std::vector<std::unique_ptr<TmpTupleFile>> *partitions, uint32_t level) {
+  if (partitions->empty()) {
+    *partitions = MakePartitions();
+  }
+  for (size_t group = 0; group < table->GetNumGroups(); group++) {
+    SpillGroup(*table, group, (*partitions)[PartitionOf(table->GetHash(group), level)].get());
+  }
+  table->Clear();
+}
+
+void AggregationExecutor::FinishSpill(std::vector<std::unique_ptr<TmpTupleFile>> *partitions, uint32_t level) {
+  if (partitions->empty()) {
+    return;
+  }
+  // The groups left in memory may also be in the spilled partitions, so they have to be re-aggregated with them.
+  SpillTable(&aht_, partitions, level);
+  for (auto &partition : *partitions) {
+    partition->Finish();
+    if (partition->GetNumTuples() > 0) {
+      pending_.push_back({std::move(partition), level});
+    }
+  }
+  partitions->clear();
+}
+
+void AggregationExecutor::Init() {
+  aht_.Clear();
+  next_group_ = 0;
+  budget_ = exec_ctx_->GetMemoryBudget();
+  partitions_.clear();
+  pending_.clear();
+  child_->Init();
+  if (exec_ctx_->GetParallelContext() != nullptr) {
+    AggregatePartition();
+    return;
+  }
+  TupleBatch batch;
+  while (child_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      hash_t hash = MakeKey(&batch.GetTuple(i));
+      MakeVal(&batch.GetTuple(i));
+      aht_.InsertCombine(key_, hash, input_);
+      SpillIfFull(&partitions_, 0);
+    }
+  }
+  FinishSpill(&partitions_, 0);
+}
+
+void AggregationExecutor::AggregatePartition() {
+  ParallelContext *parallel_ctx = exec_ctx_->GetParallelContext();
+  uint32_t worker_id = exec_ctx_->GetWorkerId();
+  uint32_t num_workers = parallel_ctx->GetNumWorkers();
+  auto exchange = parallel_ctx->GetShared<PartialExchange>(
+      plan_, [num_workers] { return std::make_shared<PartialExchange>(num_workers); });
+
+  // Pre-aggregate this worker's input, already split by the partition each group belongs to. The partial tables
+  // share the budget; when they outgrow it, they are spilled to one file per partition.
+  std::vector<AggregationHashTable> partials(num_workers, MakeTable());
+  std::vector<std::unique_ptr<TmpTupleFile>> spilled;
+  TupleBatch batch;
+  while (child_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      hash_t hash = MakeKey(&batch.GetTuple(i));
+      MakeVal(&batch.GetTuple(i));
+      partials[parallel_ctx->PartitionOf(hash)].InsertCombine(key_, hash, input_);
+    }
+    size_t usage = 0;
+    for (const auto &partial : partials) {
+      usage += partial.GetMemoryUsage();
+    }
+    if (usage <= budget_) {
+      continue;
+    }
+    if (spilled.empty()) {
+      for (uint32_t partition = 0; partition < num_workers; partition++) {
+        spilled.push_back(std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager()));
+      }
+    }
+    for (uint32_t partition = 0; partition < num_workers; partition++) {
+      for (size_t group = 0; group < partials[partition].GetNumGroups(); group++) {
+        SpillGroup(partials[partition], group, spilled[partition].get());
+      }
+      partials[partition].Clear();
+    }
+  }
+  for (auto &file : spilled) {
+    file->Finish();
+  }
+  // Each worker only writes its own row of the exchange.
+  exchange->partials_[worker_id] = std::move(partials);
+  exchange->spilled_[worker_id] = std::move(spilled);
+  parallel_ctx->ArriveAndWait();
+
+  // Every group of this partition is now here. Only this worker reads column worker_id, so it can take its own
+  // partial table over rather than copying it.
+  aht_ = std::move(exchange->partials_[worker_id][worker_id]);
+  SpillIfFull(&partitions_, 0);
+  for (uint32_t producer = 0; producer < num_workers; producer++) {
+    if (producer == worker_id) {
+      continue;
+    }
+    AggregationHashTable &partial = exchange->partials_[producer][worker_id];
+    for (size_t group = 0; group < partial.GetNumGroups(); group++) {
+      aht_.MergeGroup(partial, group);
+      SpillIfFull(&partitions_, 0);
+    }
+    // Release the partial table's memory now rather than with the exchange.
+    partial = MakeTable();
+  }
+  for (uint32_t producer = 0; producer < num_workers; producer++) {
+    if (exchange->spilled_[producer].empty()) {
+      continue;
+    }
+    Tuple tuple;
+    auto reader = exchange->spilled_[producer][worker_id]->MakeReader();
+    while (reader->Next(&tuple)) {
+      if (aht_.MergeSpilled(tuple)) {
+        SpillIfFull(&partitions_, 0);
+      }
+    }
+    reader.reset();
+    exchange->spilled_[producer][worker_id].reset();
+  }
+  FinishSpill(&partitions_, 0);
+}
+
+void AggregationExecutor::LoadNextPartition() {
+  SpilledPartition partition = std::move(pending_.back());
+  pending_.pop_back();
+  aht_.Clear();
+  next_group_ = 0;
+
+  // If the partition's groups still do not fit, they are split again with the next level's hash.
+  uint32_t level = partition.level_ + 1;
+  std::vector<std::unique_ptr<TmpTupleFile>> partitions;
+  Tuple tuple;
+  auto reader = partition.file_->MakeReader();
+  while (reader->Next(&tuple)) {
+    // A group's records are spilled together, so the table is only spilled between groups.
+    bool group_done = aht_.MergeSpilled(tuple);
+    if (group_done && level <= MAX_PARTITION_LEVEL) {
+      SpillIfFull(&partitions, level);
+    }
+  }
+  FinishSpill(&partitions, level);
+}
+
+bool AggregationExecutor::NextGroup(Tuple *tuple, Arena *arena) {
+  const AbstractExpression *having = plan_->GetHaving();
+  while (next_group_ < aht_.GetNumGroups() || !pending_.empty()) {
+    if (next_group_ == aht_.GetNumGroups()) {
+      LoadNextPartition();
+      continue;
+    }
+    std::vector<Value> group_bys = aht_.GetGroupBys(next_group_);
+    std::vector<Value> aggregates = aht_.GetAggregates(next_group_);
+    next_group_++;
+    if (having != nullptr) {
+      // A NULL result, e.g. of a comparison with NULL, does not satisfy HAVING.
+      Value satisfied = having->EvaluateAggregate(group_bys, aggregates);
+      if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+        continue;
+      }
+    }
+    const Schema *output_schema = plan_->OutputSchema();
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &col : output_schema->GetColumns()) {
+      values.push_back(col.GetExpr()->EvaluateAggregate(group_bys, aggregates));
+    }
+    *tuple = Tuple(values, output_schema, arena);
+    return true;
+  }
+  return false;
+}
+
+bool AggregationExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  if (!NextGroup(tuple, &output_arena_)) {
+    return false;
+  }
+  *rid = RID();
+  return true;
+}
+
+bool AggregationExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  while (!batch->IsFull() && NextGroup(&tuple, batch->GetArena())) {
+    batch->Append(tuple, RID());
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,381 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.cpp
+//
+// Identification: src/execution/aggregation_hash_table.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/aggregation_hash_table.h"
+#include "type/type_dispatch.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+void AggregationHashTable::AppendKey(const Value &value, std::vector<char> *key) {
+  size_t offset = key->size();
+  uint32_t size = Type::GetTypeSize(value.GetTypeId());
+  if (size == 0) {
+    // Variable length values serialize as their length followed by their bytes, if they are not NULL.
+    uint32_t length = value.GetLength();
+    size = sizeof(uint32_t) + (length == BUSTUB_VALUE_NULL ? 0 : length);
+  }
+  key->resize(offset + size);
+  value.SerializeTo(key->data() + offset);
+}
+
+void AggregationHashTable::InsertCombine(const std::vector<char> &key, hash_t hash, const std::vector<Value> &input) {
+  Combine(FindOrInsert(key.data(), key.size(), hash), input);
+}
+
+void AggregationHashTable::Combine(size_t group, const std::vector<Value> &input) {
+  Value *aggregates = &aggregates_[group * agg_types_.size()];
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    switch (agg_types_[i]) {
+      case AggregationType::CountAggregate:
+        aggregates[i] = TypeDispatch::Add(aggregates[i], ValueFactory::GetIntegerValue(1));
+        break;
+      case AggregationType::SumAggregate:
+        aggregates[i] = TypeDispatch::Add(aggregates[i], input[i]);
+        break;
+      case AggregationType::MinAggregate:
+        aggregates[i] = TypeDispatch::Min(aggregates[i], input[i]);
+        break;
+      case AggregationType::MaxAggregate:
+        aggregates[i] = TypeDispatch::Max(aggregates[i], input[i]);
+        break;
+      case AggregationType::AvgAggregate:
+        if (!input[i].IsNull()) {
+          aggregates[i] = TypeDispatch::Add(aggregates[i], input[i]);
+          avg_counts_[i][group]++;
+        }
+        break;
+      case AggregationType::CountDistinctAggregate:
+        if (!input[i].IsNull()) {
+          scratch_.clear();
+          AppendKey(input[i], &scratch_);
+          AddDistinct(group, i, std::string(scratch_.begin(), scratch_.end()));
+        }
+        break;
+      case AggregationType::ApproxCountDistinctAggregate:
+        if (!input[i].IsNull()) {
+          scratch_.clear();
+          AppendKey(input[i], &scratch_);
+          sketches_[i][group].Add(HashKey(scratch_));
+        }
+        break;
+    }
+  }
+}
+
+void AggregationHashTable::AddDistinct(size_t group, size_t i, std::string &&value) {
+  size_t size = value.size();
+  if (distinct_values_[i][group].insert(std::move(value)).second) {
+    side_bytes_ += size + DISTINCT_VALUE_OVERHEAD;
+    aggregates_[group * agg_types_.size() + i] = ValueFactory::GetIntegerValue(distinct_values_[i][group].size());
+  }
+}
+
+void AggregationHashTable::CombinePartial(size_t group, size_t i, const Value &partial) {
+  Value &aggregate = aggregates_[group * agg_types_.size() + i];
+  switch (agg_types_[i]) {
+    case AggregationType::CountAggregate:
+    case AggregationType::SumAggregate:
+    case AggregationType::AvgAggregate:
+      // Partial counts add up just like partial sums; an AVG's partial sum is one too.
+      aggregate = TypeDispatch::Add(aggregate, partial);
+      break;
+    case AggregationType::MinAggregate:
+      aggregate = TypeDispatch::Min(aggregate, partial);
+      break;
+    case AggregationType::MaxAggregate:
+      aggregate = TypeDispatch::Max(aggregate, partial);
+      break;
+    case AggregationType::CountDistinctAggregate:
+    case AggregationType::ApproxCountDistinctAggregate:
+      // These are merged from their sets and sketches.
+      break;
+  }
+}
+
+void AggregationHashTable::MergeGroup(const AggregationHashTable &other, size_t group) {
+  const char *key = other.key_data_.data() + other.key_offsets_[group];
+  uint32_t key_size = other.key_offsets_[group + 1] - other.key_offsets_[group];
+  size_t merged = FindOrInsert(key, key_size, other.hashes_[group]);
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    CombinePartial(merged, i, other.aggregates_[group * agg_types_.size() + i]);
+    switch (agg_types_[i]) {
+      case AggregationType::AvgAggregate:
+        avg_counts_[i][merged] += other.avg_counts_[i][group];
+        break;
+      case AggregationType::CountDistinctAggregate:
+        for (const auto &value : other.distinct_values_[i][group]) {
+          AddDistinct(merged, i, std::string(value));
+        }
+        break;
+      case AggregationType::ApproxCountDistinctAggregate:
+        sketches_[i][merged].Merge(other.sketches_[i][group]);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::vector<Tuple> AggregationHashTable::SpillGroup(size_t group) const {
+  // A record is laid out as its length, the key's hash, the key's length, the key, and what the record holds. The
+  // distinct values of a COUNT DISTINCT and the sketch of an APPROX COUNT DISTINCT each get records of their own,
+  // holding the aggregate's index and then one value as a length and the bytes, or the sketch; that way no record
+  // grows with the number of distinct values of its group. The group's own record comes last, holding SPILLED_GROUP
+  // and then each partial aggregate as its type followed by its serialized value, since sums can change type as they
+  // grow; an AVG's value is followed by its count.
+  uint32_t key_size = key_offsets_[group + 1] - key_offsets_[group];
+  std::vector<char> data;
+  auto append = [&data](const void *bytes, size_t size) {
+    data.insert(data.end(), static_cast<const char *>(bytes), static_cast<const char *>(bytes) + size);
+  };
+  auto begin = [&](uint32_t holds) {
+    data.assign(sizeof(uint32_t), 0);
+    append(&hashes_[group], sizeof(hash_t));
+    append(&key_size, sizeof(uint32_t));
+    append(key_data_.data() + key_offsets_[group], key_size);
+    append(&holds, sizeof(uint32_t));
+  };
+  std::vector<Tuple> records;
+  auto finish = [&]() {
+    auto length = static_cast<uint32_t>(data.size() - sizeof(uint32_t));
+    memcpy(data.data(), &length, sizeof(uint32_t));
+    records.emplace_back();
+    records.back().DeserializeFrom(data.data());
+  };
+
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    if (agg_types_[i] == AggregationType::CountDistinctAggregate) {
+      for (const auto &value : distinct_values_[i][group]) {
+        begin(i);
+        auto length = static_cast<uint32_t>(value.size());
+        append(&length, sizeof(uint32_t));
+        append(value.data(), length);
+        finish();
+      }
+    } else if (agg_types_[i] == AggregationType::ApproxCountDistinctAggregate) {
+      begin(i);
+      uint32_t size = sketches_[i][group].GetSerializedSize();
+      data.resize(data.size() + size);
+      sketches_[i][group].SerializeTo(data.data() + data.size() - size);
+      finish();
+    }
+  }
+
+  begin(SPILLED_GROUP);
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    const Value &aggregate = aggregates_[group * agg_types_.size() + i];
+    data.push_back(static_cast<char>(aggregate.GetTypeId()));
+    AppendKey(aggregate, &data);
+    if (agg_types_[i] == AggregationType::AvgAggregate) {
+      append(&avg_counts_[i][group], sizeof(int64_t));
+    }
+  }
+  finish();
+  return records;
+}
+
+bool AggregationHashTable::MergeSpilled(const Tuple &spilled) {
+  const char *data = spilled.GetData() + sizeof(hash_t);
+  uint32_t key_size;
+  memcpy(&key_size, data, sizeof(uint32_t));
+  const char *key = data + sizeof(uint32_t);
+  data = key + key_size;
+  uint32_t holds;
+  memcpy(&holds, data, sizeof(uint32_t));
+  data += sizeof(uint32_t);
+  // The records of a group can come back in any order; whichever comes first creates the group.
+  size_t group = FindOrInsert(key, key_size, SpilledHash(spilled));
+
+  if (holds != SPILLED_GROUP) {
+    if (agg_types_[holds] == AggregationType::CountDistinctAggregate) {
+      uint32_t length;
+      memcpy(&length, data, sizeof(uint32_t));
+      AddDistinct(group, holds, std::string(data + sizeof(uint32_t), length));
+    } else {
+      HyperLogLog sketch;
+      sketch.DeserializeFrom(data);
+      sketches_[holds][group].Merge(sketch);
+    }
+    return false;
+  }
+
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    auto type = static_cast<TypeId>(*data++);
+    CombinePartial(group, i, Value::DeserializeFrom(data, type));
+    data += SerializedSize(data, type);
+    if (agg_types_[i] == AggregationType::AvgAggregate) {
+      int64_t count;
+      memcpy(&count, data, sizeof(int64_t));
+      avg_counts_[i][group] += count;
+      data += sizeof(int64_t);
+    }
+  }
+  return true;
+}
+
+std::vector<Value> AggregationHashTable::GetAggregates(size_t group) const {
+  std::vector<Value> aggregates(aggregates_.begin() + group * agg_types_.size(),
+                                aggregates_.begin() + (group + 1) * agg_types_.size());
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    if (agg_types_[i] == AggregationType::AvgAggregate) {
+      int64_t count = avg_counts_[i][group];
+      aggregates[i] = count == 0 ? ValueFactory::GetNullValueByType(TypeId::DECIMAL)
+                                 : ValueFactory::GetDecimalValue(
+                                       aggregates[i].CastAs(TypeId::DECIMAL).GetAs<double>() / count);
+    } else if (agg_types_[i] == AggregationType::ApproxCountDistinctAggregate) {
+      aggregates[i] = ValueFactory::GetIntegerValue(static_cast<int32_t>(sketches_[i][group].Estimate()));
+    }
+  }
+  return aggregates;
+}
+
+uint32_t AggregationHashTable::SerializedSize(const char *data, TypeId type) {
+  uint32_t size = Type::GetTypeSize(type);
+  if (size == 0) {
+    uint32_t length;
+    memcpy(&length, data, sizeof(uint32_t));
+    size = sizeof(uint32_t) + (length == BUSTUB_VALUE_NULL ? 0 : length);
+  }
+  return size;
+}
+
+std::vector<Value> AggregationHashTable::GetGroupBys(size_t group) const {
+  std::vector<Value> group_bys;
+  group_bys.reserve(key_types_.size());
+  const char *key = key_data_.data() + key_offsets_[group];
+  for (TypeId type : key_types_) {
+    group_bys.push_back(Value::DeserializeFrom(key, type));
+    key += SerializedSize(key, type);
+  }
+  return group_bys;
+}
+
+void AggregationHashTable::Clear() {
+  // Give the memory back too, since a table is cleared when it outgrows its budget.
+  slots_ = std::vector<Slot>();
+  key_data_ = std::vector<char>();
+  key_offsets_ = std::vector<size_t>{0};
+  hashes_ = std::vector<hash_t>();
+  aggregates_ = std::vector<Value>();
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    avg_counts_[i] = std::vector<int64_t>();
+    distinct_values_[i] = std::vector<std::unordered_set<std::string>>();
+    sketches_[i] = std::vector<HyperLogLog>();
+  }
+  side_bytes_ = 0;
+}
+
+void AggregationHashTable::ResetToGroup(const std::vector<char> &key, hash_t hash) {
+  if (hashes_.size() != 1) {
+    Clear();
+    FindOrInsert(key.data(), key.size(), hash);
+    return;
+  }
+  // The only group went into an empty table, so its slot is the first of its probe sequence.
+  const size_t mask = slots_.size() - 1;
+  slots_[hashes_[0] & mask] = Slot{0, 0};
+  slots_[hash & mask] = Slot{TagOf(hash), 1};
+  key_data_.assign(key.begin(), key.end());
+  key_offsets_[1] = key_data_.size();
+  hashes_[0] = hash;
+  side_bytes_ = 0;
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    aggregates_[i] = InitialAggregate(agg_types_[i]);
+    if (agg_types_[i] == AggregationType::AvgAggregate) {
+      avg_counts_[i][0] = 0;
+    } else if (agg_types_[i] == AggregationType::CountDistinctAggregate) {
+      distinct_values_[i][0].clear();
+    } else if (agg_types_[i] == AggregationType::ApproxCountDistinctAggregate) {
+      sketches_[i][0].Clear();
+      side_bytes_ += HyperLogLog::NUM_REGISTERS;
+    }
+  }
+}
+
+Value AggregationHashTable::InitialAggregate(AggregationType type) {
+  switch (type) {
+    case AggregationType::CountAggregate:
+    case AggregationType::SumAggregate:
+    case AggregationType::CountDistinctAggregate:
+    case AggregationType::ApproxCountDistinctAggregate:
+      // Counts and sums start at zero.
+      return ValueFactory::GetIntegerValue(0);
+    case AggregationType::MinAggregate:
+      // Min starts at INT_MAX.
+      return ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX);
+    case AggregationType::MaxAggregate:
+      // Max starts at INT_MIN.
+      return ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN);
+    case AggregationType::AvgAggregate:
+      // The sum is kept as a decimal, so that it does not overflow as an integer.
+      return ValueFactory::GetDecimalValue(0);
+  }
+  UNREACHABLE("unknown aggregation type");
+}
+
+size_t AggregationHashTable::FindOrInsert(const char *key, uint32_t key_size, hash_t hash) {
+  if ((hashes_.size() + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  const size_t mask = slots_.size() - 1;
+  const uint32_t tag = TagOf(hash);
+  for (size_t idx = hash & mask;; idx = (idx + 1) & mask) {
+    Slot &slot = slots_[idx];
+    if (slot.group_ == 0) {
+      // The key is not in the table; the group goes into the first free slot of its probe sequence.
+      size_t group = hashes_.size();
+      slot = {tag, static_cast<uint32_t>(group + 1)};
+      key_data_.insert(key_data_.end(), key, key + key_size);
+      key_offsets_.push_back(key_data_.size());
+      hashes_.push_back(hash);
+      for (size_t i = 0; i < agg_types_.size(); i++) {
+        aggregates_.emplace_back(InitialAggregate(agg_types_[i]));
+        if (agg_types_[i] == AggregationType::AvgAggregate) {
+          avg_counts_[i].push_back(0);
+        } else if (agg_types_[i] == AggregationType::CountDistinctAggregate) {
+          distinct_values_[i].emplace_back();
+        } else if (agg_types_[i] == AggregationType::ApproxCountDistinctAggregate) {
+          sketches_[i].emplace_back();
+          side_bytes_ += HyperLogLog::NUM_REGISTERS;
+        }
+      }
+      return group;
+    }
+    size_t group = slot.group_ - 1;
+    if (slot.tag_ == tag && key_offsets_[group + 1] - key_offsets_[group] == key_size &&
+        memcmp(key_data_.data() + key_offsets_[group], key, key_size) == 0) {
+      return group;
+    }
+  }
+}
+
+void AggregationHashTable::Grow() {
+  slots_.assign(slots_.empty() ? INITIAL_SLOTS : slots_.size() * 2, Slot{0, 0});
+  const size_t mask = slots_.size() - 1;
+  for (size_t group = 0; group < hashes_.size(); group++) {
+    size_t idx = hashes_[group] & mask;
+    while (slots_[idx].group_ != 0) {
+      idx = (idx + 1) & mask;
+    }
+    slots_[idx] = {TagOf(hashes_[group]), static_cast<uint32_t>(group + 1)};
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// cardinality_estimator.cpp
+//
+// Identification: src/execution/cardinality_estimator.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/cardinality_estimator.h"
+
+#include <algorithm>
+
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/parallel_seq_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/top_n_plan.h"
+
+namespace bustub {
+
+size_t CardinalityEstimator::EstimateScan(TableMetadata *table_info, const AbstractExpression *predicate) {
+  size_t num_tuples = table_info->table_->GetApproxNumTuples();
+  return predicate == nullptr ? num_tuples : num_tuples / PREDICATE_SELECTIVITY_INVERSE;
+}
+
+size_t CardinalityEstimator::Estimate(const AbstractPlanNode *plan, Catalog *catalog) {
+  switch (plan->GetType()) {
+    case PlanType::SeqScan: {
+      auto scan_plan = dynamic_cast<const SeqScanPlanNode *>(plan);
+      return EstimateScan(catalog->GetTable(scan_plan->GetTableOid()), scan_plan->GetPredicate());
+    }
+    case PlanType::ParallelSeqScan: {
+      auto scan_plan = dynamic_cast<const ParallelSeqScanPlanNode *>(plan);
+      return EstimateScan(catalog->GetTable(scan_plan->GetTableOid()), scan_plan->GetPredicate());
+    }
+    case PlanType::IndexScan: {
+      auto scan_plan = dynamic_cast<const IndexScanPlanNode *>(plan);
+      IndexInfo *index_info = catalog->GetIndex(scan_plan->GetIndexOid());
+      return EstimateScan(catalog->GetTable(index_info->table_name_), scan_plan->GetPredicate());
+    }
+    case PlanType::Limit:
+      return std::min(dynamic_cast<const LimitPlanNode *>(plan)->GetLimit(), Estimate(plan->GetChildAt(0), catalog));
+    case PlanType::TopN:
+      return std::min(dynamic_cast<const TopNPlanNode *>(plan)->GetLimit(), Estimate(plan->GetChildAt(0), catalog));
+    case PlanType::Aggregation:
+    case PlanType::StreamingAggregate:
+      // Without group bys there is exactly one group; otherwise at most one per input tuple.
+      if (dynamic_cast<const AggregationPlanNode *>(plan)->GetGroupBys().empty()) {
+        return 1;
+      }
+      return Estimate(plan->GetChildAt(0), catalog);
+    case PlanType::HashJoin:
+    case PlanType::MergeJoin:
+    case PlanType::NestedLoopJoin:
+      // The common equi-join is on a key of one side, and then outputs at most one tuple per tuple of the other.
+      return std::max(Estimate(plan->GetChildAt(0), catalog), Estimate(plan->GetChildAt(1), catalog));
+    case PlanType::NestedIndexJoin:
+      return Estimate(dynamic_cast<const NestedIndexJoinPlanNode *>(plan)->GetChildPlan(), catalog);
+    case PlanType::Insert:
+    case PlanType::Update:
+    case PlanType::Delete:
+      return 0;
+    default:
+      // Sorts, gathers and fetches output as many tuples as they take in.
+      return Estimate(plan->GetChildAt(0), catalog);
+  }
+}
+
+}  // namespace bustub
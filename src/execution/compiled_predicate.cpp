@@ -0,0 +1,188 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_predicate.cpp
+//
+// Identification: src/execution/compiled_predicate.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/compiled_predicate.h"
+
+#include <functional>
+#include <utility>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+
+namespace bustub {
+
+namespace {
+
+bool IsFixedWidthNumeric(TypeId type) {
+  switch (type) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** @return the comparison that holds for (b, a) exactly when comp_type holds for (a, b) */
+ComparisonType Mirror(ComparisonType comp_type) {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+/** Calls picker with the function object performing the comparison. */
+template <typename Picker>
+auto WithOp(ComparisonType comp_type, Picker &&picker) {
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return picker(std::equal_to<>());
+    case ComparisonType::NotEqual:
+      return picker(std::not_equal_to<>());
+    case ComparisonType::LessThan:
+      return picker(std::less<>());
+    case ComparisonType::LessThanOrEqual:
+      return picker(std::less_equal<>());
+    case ComparisonType::GreaterThan:
+      return picker(std::greater<>());
+    case ComparisonType::GreaterThanOrEqual:
+    default:
+      return picker(std::greater_equal<>());
+  }
+}
+
+}  // namespace
+
+CompiledPredicate::CompiledPredicate(const AbstractExpression *predicate, const Schema *schema)
+    : predicate_(predicate), schema_(schema) {
+  if (predicate_ == nullptr) {
+    kernel_ = &AlwaysTrue;
+    compiled_ = true;
+    return;
+  }
+  compiled_ = Compile();
+  if (!compiled_) {
+    kernel_ = &Interpret;
+  }
+}
+
+bool CompiledPredicate::Interpret(const CompiledPredicate *self, const Tuple *tuple) {
+  Value result = self->predicate_->Evaluate(tuple, self->schema_);
+  return !result.IsNull() && result.GetAs<bool>();
+}
+
+template <typename Op>
+CompiledPredicate::Kernel CompiledPredicate::ColumnConstantKernel(TypeId column_type, bool as_decimal) {
+  switch (column_type) {
+    case TypeId::TINYINT:
+      return as_decimal ? &ColumnConstant<int8_t, double, Op> : &ColumnConstant<int8_t, int64_t, Op>;
+    case TypeId::SMALLINT:
+      return as_decimal ? &ColumnConstant<int16_t, double, Op> : &ColumnConstant<int16_t, int64_t, Op>;
+    case TypeId::INTEGER:
+      return as_decimal ? &ColumnConstant<int32_t, double, Op> : &ColumnConstant<int32_t, int64_t, Op>;
+    case TypeId::BIGINT:
+      return as_decimal ? &ColumnConstant<int64_t, double, Op> : &ColumnConstant<int64_t, int64_t, Op>;
+    case TypeId::DECIMAL:
+      return &ColumnConstant<double, double, Op>;
+    default:
+      return nullptr;
+  }
+}
+
+template <typename Op>
+CompiledPredicate::Kernel CompiledPredicate::ColumnColumnKernel(TypeId column_type) {
+  switch (column_type) {
+    case TypeId::TINYINT:
+      return &ColumnColumn<int8_t, Op>;
+    case TypeId::SMALLINT:
+      return &ColumnColumn<int16_t, Op>;
+    case TypeId::INTEGER:
+      return &ColumnColumn<int32_t, Op>;
+    case TypeId::BIGINT:
+      return &ColumnColumn<int64_t, Op>;
+    case TypeId::DECIMAL:
+      return &ColumnColumn<double, Op>;
+    default:
+      return nullptr;
+  }
+}
+
+bool CompiledPredicate::Compile() {
+  auto comparison = dynamic_cast<const ComparisonExpression *>(predicate_);
+  if (comparison == nullptr) {
+    return false;
+  }
+  ComparisonType comp_type = comparison->GetComparisonType();
+  const AbstractExpression *lhs = comparison->GetChildAt(0);
+  const AbstractExpression *rhs = comparison->GetChildAt(1);
+  if (dynamic_cast<const ColumnValueExpression *>(lhs) == nullptr) {
+    // Put the column on the left: 5 < colA is colA > 5.
+    std::swap(lhs, rhs);
+    comp_type = Mirror(comp_type);
+  }
+  auto lhs_column = dynamic_cast<const ColumnValueExpression *>(lhs);
+  if (lhs_column == nullptr) {
+    return false;
+  }
+  const Column &left = schema_->GetColumn(lhs_column->GetColIdx());
+  if (!IsFixedWidthNumeric(left.GetType())) {
+    return false;
+  }
+
+  if (auto rhs_column = dynamic_cast<const ColumnValueExpression *>(rhs); rhs_column != nullptr) {
+    const Column &right = schema_->GetColumn(rhs_column->GetColIdx());
+    if (right.GetType() != left.GetType()) {
+      return false;
+    }
+    lhs_offset_ = left.GetOffset();
+    rhs_offset_ = right.GetOffset();
+    kernel_ = WithOp(comp_type, [&left](auto op) { return ColumnColumnKernel<decltype(op)>(left.GetType()); });
+    return true;
+  }
+
+  if (dynamic_cast<const ConstantValueExpression *>(rhs) == nullptr) {
+    return false;
+  }
+  Value constant = rhs->Evaluate(nullptr, schema_);
+  if (!IsFixedWidthNumeric(constant.GetTypeId())) {
+    return false;
+  }
+  if (constant.IsNull()) {
+    kernel_ = &AlwaysFalse;
+    return true;
+  }
+  // Integers compare exactly as 64-bit integers; once a DECIMAL is involved, both sides compare as doubles.
+  bool as_decimal = left.GetType() == TypeId::DECIMAL || constant.GetTypeId() == TypeId::DECIMAL;
+  column_comparison_ = {left.GetType(), left.GetOffset(), comp_type, as_decimal, 0, 0};
+  if (as_decimal) {
+    column_comparison_.decimal_constant_ = constant.CastAs(TypeId::DECIMAL).GetAs<double>();
+  } else {
+    column_comparison_.integer_constant_ = constant.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+  }
+  has_column_comparison_ = true;
+  kernel_ = WithOp(comp_type,
+                   [&left, as_decimal](auto op) { return ColumnConstantKernel<decltype(op)>(left.GetType(), as_decimal); });
+  return true;
+}
+
+}  // namespace bustub
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// exchange_queue.cpp
+//
+// Identification: src/execution/exchange_queue.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/exchange_queue.h"
+
+#include <utility>
+
+namespace bustub {
+
+bool ExchangeQueue::Push(TupleBatch &&batch) {
+  std::unique_lock latch(latch_);
+  not_full_.wait(latch, [this] { return closed_ || batches_.size() < capacity_; });
+  if (closed_) {
+    return false;
+  }
+  batches_.push_back(std::move(batch));
+  not_empty_.notify_one();
+  return true;
+}
+
+void ExchangeQueue::ProducerDone() {
+  std::scoped_lock latch(latch_);
+  num_producers_--;
+  if (num_producers_ == 0) {
+    not_empty_.notify_all();
+  }
+}
+
+void ExchangeQueue::Fail(std::exception_ptr error) {
+  std::scoped_lock latch(latch_);
+  if (error_ == nullptr) {
+    error_ = std::move(error);
+  }
+  not_empty_.notify_all();
+}
+
+bool ExchangeQueue::Pop(TupleBatch *batch) {
+  std::unique_lock latch(latch_);
+  not_empty_.wait(latch, [this] { return error_ != nullptr || !batches_.empty() || num_producers_ == 0; });
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  if (batches_.empty()) {
+    return false;
+  }
+  *batch = std::move(batches_.front());
+  batches_.pop_front();
+  not_full_.notify_one();
+  return true;
+}
+
+void ExchangeQueue::Close() {
+  std::scoped_lock latch(latch_);
+  closed_ = true;
+  batches_.clear();
+  not_full_.notify_all();
+}
+
+void ExchangeQueue::WaitForProducers() {
+  std::unique_lock latch(latch_);
+  not_empty_.wait(latch, [this] { return num_producers_ == 0; });
+}
+
+}  // namespace bustub
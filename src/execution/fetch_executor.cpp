@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fetch_executor.cpp
+//
+// Identification: src/execution/fetch_executor.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <utility>
+
+#include "execution/executors/fetch_executor.h"
+
+namespace bustub {
+
+FetchExecutor::FetchExecutor(ExecutorContext *exec_ctx, const FetchPlanNode *plan,
+                             std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void FetchExecutor::Init() {
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
+  child_->Init();
+}
+
+bool FetchExecutor::Fetch(const Tuple &child_tuple, Tuple *tuple, RID *rid, Arena *arena) {
+  const Schema *child_schema = child_->GetOutputSchema();
+  *rid = RID(child_tuple.GetValue(child_schema, plan_->GetRidColIdx()).GetAs<int64_t>());
+  // The table tuple is read in place; only the output is copied.
+  if (!table_info_->table_->GetTupleView(*rid, &fetched_, exec_ctx_->GetTransaction())) {
+    return false;
+  }
+  const Schema *table_schema = &table_info_->schema_;
+  const Schema *output_schema = plan_->OutputSchema();
+  values_.clear();
+  for (const auto &col : output_schema->GetColumns()) {
+    values_.push_back(col.GetExpr()->EvaluateJoin(&child_tuple, child_schema, &fetched_.GetTuple(), table_schema));
+  }
+  fetched_.Reset();
+  *tuple = Tuple(values_, output_schema, arena);
+  return true;
+}
+
+bool FetchExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  Tuple child_tuple;
+  RID child_rid;
+  while (child_->Next(&child_tuple, &child_rid)) {
+    if (Fetch(child_tuple, tuple, rid, &output_arena_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FetchExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  RID rid;
+  // Each child batch makes at most one output batch, so the output batch never overflows.
+  while (batch->IsEmpty() && child_->NextBatch(&child_batch_)) {
+    for (size_t i = 0; i < child_batch_.Size(); i++) {
+      if (Fetch(child_batch_.GetTuple(i), &tuple, &rid, batch->GetArena())) {
+        batch->Append(tuple, rid);
+      }
+    }
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
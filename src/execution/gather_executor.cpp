@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include "execution/executors/gather_executor.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "execution/executor_factory.h"
+
+namespace bustub {
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+GatherExecutor::~GatherExecutor() { Stop(); }
+
+void GatherExecutor::Stop() {
+  if (queue_ != nullptr) {
+    queue_->Close();
+    parallel_ctx_->Abort();
+    queue_->WaitForProducers();
+  }
+  workers_.clear();
+  worker_ctxs_.clear();
+  queue_.reset();
+  parallel_ctx_.reset();
+}
+
+void GatherExecutor::Init() {
+  Stop();
+  BUSTUB_ASSERT(exec_ctx_->GetParallelContext() == nullptr, "Gathers cannot be nested.");
+  ThreadPool *thread_pool = exec_ctx_->GetThreadPool();
+  BUSTUB_ASSERT(thread_pool != nullptr, "Gather needs the thread pool of an ExecutionEngine.");
+  batch_.Clear();
+  batch_idx_ = 0;
+
+  // The workers wait for each other at barriers, so only as many are started as there are idle threads to run them
+  // all at once. With no idle thread, a single worker has nobody to wait for, and is queued like any other task.
+  size_t wanted = plan_->GetNumWorkers() == 0 ? thread_pool->GetNumThreads() : plan_->GetNumWorkers();
+  auto num_workers = static_cast<uint32_t>(thread_pool->TryReserve(wanted));
+  bool reserved = num_workers > 0;
+  num_workers = std::max(num_workers, 1U);
+  parallel_ctx_ = std::make_unique<ParallelContext>(num_workers);
+  size_t budget = exec_ctx_->GetMemoryBudget();
+  for (uint32_t i = 0; i < num_workers; i++) {
+    auto worker_ctx = std::make_unique<ExecutorContext>(exec_ctx_->GetTransaction(), exec_ctx_->GetCatalog(),
+                                                        exec_ctx_->GetBufferPoolManager(),
+                                                        exec_ctx_->GetTransactionManager(), exec_ctx_->GetLockManager());
+    // The workers share the memory the query may use.
+    worker_ctx->SetMemoryBudget(budget == std::numeric_limits<size_t>::max() ? budget : budget / num_workers);
+    worker_ctx->SetThreadPool(thread_pool);
+    worker_ctx->SetWorker(parallel_ctx_.get(), i);
+    workers_.push_back(ExecutorFactory::CreateExecutor(worker_ctx.get(), plan_->GetChildPlan()));
+    worker_ctxs_.push_back(std::move(worker_ctx));
+  }
+
+  queue_ = std::make_unique<ExchangeQueue>(num_workers);
+  for (uint32_t i = 0; i < num_workers; i++) {
+    if (reserved) {
+      thread_pool->SubmitReserved([this, i] { Work(i); });
+    } else {
+      thread_pool->Submit([this, i] { Work(i); });
+    }
+  }
+}
+
+void GatherExecutor::Work(uint32_t worker_id) {
+  AbstractExecutor *executor = workers_[worker_id].get();
+  try {
+    executor->Init();
+    TupleBatch batch;
+    while (executor->NextBatch(&batch)) {
+      if (!queue_->Push(std::move(batch))) {
+        break;
+      }
+      batch = TupleBatch();
+    }
+  } catch (...) {
+    // Report the error before aborting, so that the consumer sees it rather than the other workers' aborts.
+    queue_->Fail(std::current_exception());
+    parallel_ctx_->Abort();
+  }
+  queue_->ProducerDone();
+}
+
+bool GatherExecutor::Next(Tuple *tuple, RID *rid) {
+  while (batch_idx_ >= batch_.Size()) {
+    batch_idx_ = 0;
+    if (!queue_->Pop(&batch_)) {
+      batch_.Clear();
+      return false;
+    }
+  }
+  // The workers' batches carry the memory of their tuples, so the tuple is valid until batch_ is replaced.
+  *tuple = batch_.GetTuple(batch_idx_);
+  *rid = batch_.GetRid(batch_idx_);
+  batch_idx_++;
+  return true;
+}
+
+bool GatherExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  RID rid;
+  while (!batch->IsFull() && Next(&tuple, &rid)) {
+    batch->Append(Tuple(tuple, batch->GetArena()), rid);
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
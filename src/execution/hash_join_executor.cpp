@@ -0,0 +1,345 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_join_executor.cpp
+//
+// Identification: src/execution/hash_join_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/hash_join_executor.h"
+
+#include "common/util/hash_util.h"
+#include "execution/cardinality_estimator.h"
+
+namespace bustub {
+
+HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
+                                   std::unique_ptr<AbstractExecutor> &&left_executor,
+                                   std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+HashJoinKey HashJoinExecutor::MakeKey(const Tuple *tuple, const Schema *schema,
+                                      const std::vector<const AbstractExpression *> &key_exprs) {
+  std::vector<Value> keys;
+  keys.reserve(key_exprs.size());
+  for (const auto &expr : key_exprs) {
+    keys.emplace_back(expr->Evaluate(tuple, schema));
+  }
+  return {keys};
+}
+
+uint32_t HashJoinExecutor::PartitionOf(const HashJoinKey &key, uint32_t level) {
+  return HashUtil::Mix64(std::hash<HashJoinKey>{}(key) + level) % NUM_PARTITIONS;
+}
+
+std::vector<std::unique_ptr<TmpTupleFile>> HashJoinExecutor::MakePartitions() {
+  std::vector<std::unique_ptr<TmpTupleFile>> partitions;
+  partitions.reserve(NUM_PARTITIONS);
+  for (uint32_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions.push_back(std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager()));
+  }
+  return partitions;
+}
+
+void HashJoinExecutor::InsertBuild(HashJoinKey &&key, Tuple &&tuple) {
+  ht_bytes_ += Footprint(tuple);
+  ht_[std::move(key)].push_back(std::move(tuple));
+}
+
+void HashJoinExecutor::SpillBuild(bool keep_first) {
+  for (auto iter = ht_.begin(); iter != ht_.end();) {
+    uint32_t partition = PartitionOf(iter->first, 0);
+    if (keep_first && partition == 0) {
+      ++iter;
+      continue;
+    }
+    for (const auto &tuple : iter->second) {
+      build_partitions_[partition]->Append(tuple);
+      ht_bytes_ -= Footprint(tuple);
+    }
+    iter = ht_.erase(iter);
+  }
+}
+
+void HashJoinExecutor::AddBuildTuple(const Tuple &build_tuple, size_t budget) {
+  HashJoinKey key = MakeKey(&build_tuple, BuildSchema(), BuildKeys());
+  // NULL keys can never satisfy the equi-join, so they are not worth keeping.
+  if (key.HasNull()) {
+    return;
+  }
+  uint32_t partition = spilled_ ? PartitionOf(key, 0) : 0;
+  if (spilled_ && (partition != 0 || !first_resident_)) {
+    build_partitions_[partition]->Append(build_tuple);
+    return;
+  }
+
+  // The tuple is only valid as long as the child's batch, but the table keeps it until the probe is done.
+  InsertBuild(std::move(key), build_tuple.Materialize());
+  if (ht_bytes_ > budget) {
+    if (!spilled_) {
+      // Switch to partitioning, keeping the first partition in memory if it fits on its own.
+      spilled_ = true;
+      first_resident_ = true;
+      build_partitions_ = MakePartitions();
+      SpillBuild(true);
+    }
+    if (ht_bytes_ > budget) {
+      first_resident_ = false;
+      SpillBuild(false);
+    }
+  }
+}
+
+void HashJoinExecutor::Init() {
+  ht_.clear();
+  ht_bytes_ = 0;
+  spilled_ = false;
+  first_resident_ = false;
+  build_partitions_.clear();
+  probe_partitions_.clear();
+  probe_done_ = false;
+  pending_.clear();
+  probe_reader_.reset();
+  probe_file_.reset();
+  probe_batch_.Clear();
+  probe_batch_idx_ = 0;
+  probe_tuple_ = nullptr;
+  matches_ = nullptr;
+  match_idx_ = 0;
+
+  exchange_.reset();
+  probe_producer_ = 0;
+  exchange_reader_.reset();
+
+  // The smaller input is hashed, so that less of the join has to fit in memory.
+  Catalog *catalog = exec_ctx_->GetCatalog();
+  build_right_ = CardinalityEstimator::Estimate(plan_->GetRightPlan(), catalog) <
+                 CardinalityEstimator::Estimate(plan_->GetLeftPlan(), catalog);
+
+  size_t budget = exec_ctx_->GetMemoryBudget();
+  if (exec_ctx_->GetParallelContext() != nullptr) {
+    BuildPartition(budget);
+  } else {
+    BuildExecutor()->Init();
+    TupleBatch batch;
+    while (BuildExecutor()->NextBatch(&batch)) {
+      for (size_t i = 0; i < batch.Size(); i++) {
+        AddBuildTuple(batch.GetTuple(i), budget);
+      }
+    }
+    ProbeExecutor()->Init();
+  }
+
+  if (spilled_) {
+    for (auto &partition : build_partitions_) {
+      partition->Finish();
+    }
+    probe_partitions_ = MakePartitions();
+  }
+}
+
+void HashJoinExecutor::BuildPartition(size_t budget) {
+  ParallelContext *parallel_ctx = exec_ctx_->GetParallelContext();
+  uint32_t worker_id = exec_ctx_->GetWorkerId();
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  exchange_ = parallel_ctx->GetShared<JoinExchange>(plan_, [parallel_ctx, bpm, budget] {
+    return std::make_shared<JoinExchange>(parallel_ctx->GetNumWorkers(), bpm, budget);
+  });
+
+  // Send the tuples of both sides to the worker that owns their key. NULL keys never join, so they go nowhere.
+  auto exchange_side = [parallel_ctx, worker_id](AbstractExecutor *child, const Schema *schema,
+                                                  const std::vector<const AbstractExpression *> &key_exprs,
+                                                  PartitionExchange *exchange) {
+    child->Init();
+    TupleBatch batch;
+    while (child->NextBatch(&batch)) {
+      for (size_t i = 0; i < batch.Size(); i++) {
+        HashJoinKey key = MakeKey(&batch.GetTuple(i), schema, key_exprs);
+        if (!key.HasNull()) {
+          exchange->Add(worker_id, parallel_ctx->PartitionOf(std::hash<HashJoinKey>{}(key)), batch.GetTuple(i));
+        }
+      }
+    }
+    exchange->Finish(worker_id);
+  };
+  exchange_side(BuildExecutor(), BuildSchema(), BuildKeys(), &exchange_->build_);
+  exchange_side(ProbeExecutor(), ProbeSchema(), ProbeKeys(), &exchange_->probe_);
+  parallel_ctx->ArriveAndWait();
+
+  for (uint32_t producer = 0; producer < exchange_->build_.GetNumProducers(); producer++) {
+    auto reader = exchange_->build_.MakeReader(producer, worker_id);
+    while (const Tuple *tuple = reader->Next()) {
+      AddBuildTuple(*tuple, budget);
+    }
+  }
+}
+
+bool HashJoinExecutor::NextProbeBatch() {
+  if (exchange_ == nullptr) {
+    return ProbeExecutor()->NextBatch(&probe_batch_);
+  }
+  probe_batch_.Clear();
+  uint32_t worker_id = exec_ctx_->GetWorkerId();
+  while (!probe_batch_.IsFull() && probe_producer_ < exchange_->probe_.GetNumProducers()) {
+    if (exchange_reader_ == nullptr) {
+      exchange_reader_ = exchange_->probe_.MakeReader(probe_producer_, worker_id);
+    }
+    const Tuple *tuple = exchange_reader_->Next();
+    if (tuple == nullptr) {
+      probe_producer_++;
+      exchange_reader_.reset();
+      continue;
+    }
+    probe_batch_.Append(Tuple(*tuple, probe_batch_.GetArena()), tuple->GetRid());
+  }
+  return !probe_batch_.IsEmpty();
+}
+
+void HashJoinExecutor::Probe(const HashJoinKey &key) {
+  auto iter = ht_.find(key);
+  matches_ = iter == ht_.end() ? nullptr : &iter->second;
+  match_idx_ = 0;
+}
+
+bool HashJoinExecutor::LoadNextPartition() {
+  const Schema *build_schema = BuildSchema();
+  const Schema *probe_schema = ProbeSchema();
+  size_t budget = exec_ctx_->GetMemoryBudget();
+  while (!pending_.empty()) {
+    PartitionPair pair = std::move(pending_.back());
+    pending_.pop_back();
+    size_t build_bytes = pair.build_->GetNumBytes() + pair.build_->GetNumTuples() * sizeof(Tuple);
+
+    if (build_bytes > budget && pair.level_ < MAX_PARTITION_LEVEL) {
+      // Still too big: split both sides again with the next level's hash.
+      uint32_t level = pair.level_ + 1;
+      auto builds = MakePartitions();
+      auto probes = MakePartitions();
+      Tuple tuple;
+      auto build_reader = pair.build_->MakeReader();
+      while (build_reader->Next(&tuple)) {
+        builds[PartitionOf(MakeKey(&tuple, build_schema, BuildKeys()), level)]->Append(tuple);
+      }
+      auto probe_reader = pair.probe_->MakeReader();
+      while (probe_reader->Next(&tuple)) {
+        probes[PartitionOf(MakeKey(&tuple, probe_schema, ProbeKeys()), level)]->Append(tuple);
+      }
+      for (uint32_t i = 0; i < NUM_PARTITIONS; i++) {
+        builds[i]->Finish();
+        probes[i]->Finish();
+        if (builds[i]->GetNumTuples() > 0 && probes[i]->GetNumTuples() > 0) {
+          pending_.push_back({std::move(builds[i]), std::move(probes[i]), level});
+        }
+      }
+      continue;
+    }
+
+    ht_.clear();
+    ht_bytes_ = 0;
+    Tuple tuple;
+    auto build_reader = pair.build_->MakeReader();
+    while (build_reader->Next(&tuple)) {
+      HashJoinKey key = MakeKey(&tuple, build_schema, BuildKeys());
+      InsertBuild(std::move(key), std::move(tuple));
+    }
+    probe_reader_.reset();
+    probe_file_ = std::move(pair.probe_);
+    probe_reader_ = probe_file_->MakeReader();
+    return true;
+  }
+  return false;
+}
+
+bool HashJoinExecutor::Produce(Tuple *tuple, RID *rid, Arena *arena) {
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  const Schema *probe_schema = ProbeSchema();
+  while (true) {
+    if (matches_ == nullptr || match_idx_ >= matches_->size()) {
+      matches_ = nullptr;
+      if (!probe_done_) {
+        if (probe_batch_idx_ >= probe_batch_.Size()) {
+          probe_batch_idx_ = 0;
+          if (!NextProbeBatch()) {
+            probe_done_ = true;
+            // The resident partition has already been joined; the others are joined pair by pair from disk.
+            for (uint32_t i = first_resident_ ? 1 : 0; i < build_partitions_.size(); i++) {
+              probe_partitions_[i]->Finish();
+              if (build_partitions_[i]->GetNumTuples() > 0 && probe_partitions_[i]->GetNumTuples() > 0) {
+                pending_.push_back({std::move(build_partitions_[i]), std::move(probe_partitions_[i]), 0});
+              }
+            }
+            build_partitions_.clear();
+            probe_partitions_.clear();
+            ht_.clear();
+          }
+          continue;
+        }
+        probe_tuple_ = &probe_batch_.GetTuple(probe_batch_idx_++);
+        HashJoinKey key = MakeKey(probe_tuple_, probe_schema, ProbeKeys());
+        uint32_t partition = spilled_ ? PartitionOf(key, 0) : 0;
+        if (!spilled_ || (partition == 0 && first_resident_)) {
+          Probe(key);
+        } else if (!key.HasNull()) {
+          probe_partitions_[partition]->Append(*probe_tuple_);
+        }
+        continue;
+      }
+
+      if (probe_reader_ == nullptr || !probe_reader_->Next(&spilled_tuple_)) {
+        if (!LoadNextPartition()) {
+          return false;
+        }
+        continue;
+      }
+      probe_tuple_ = &spilled_tuple_;
+      Probe(MakeKey(probe_tuple_, probe_schema, ProbeKeys()));
+      continue;
+    }
+
+    const Tuple *build_tuple = &(*matches_)[match_idx_++];
+    const Tuple *left_tuple = build_right_ ? probe_tuple_ : build_tuple;
+    const Tuple *right_tuple = build_right_ ? build_tuple : probe_tuple_;
+    if (plan_->Predicate() != nullptr) {
+      // A NULL result, e.g. of a comparison with NULL, does not satisfy the predicate.
+      Value satisfied = plan_->Predicate()->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
+      if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+        continue;
+      }
+    }
+
+    const Schema *output_schema = plan_->OutputSchema();
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &col : output_schema->GetColumns()) {
+      values.push_back(col.GetExpr()->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema));
+    }
+    *tuple = Tuple(values, output_schema, arena);
+    *rid = right_tuple->GetRid();
+    return true;
+  }
+}
+
+bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  return Produce(tuple, rid, &output_arena_);
+}
+
+bool HashJoinExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  RID rid;
+  while (!batch->IsFull() && Produce(&tuple, &rid, batch->GetArena())) {
+    batch->Append(tuple, rid);
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_executor,
+                                     std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {
+  for (const auto &key_expr : plan_->GetLeftKeys()) {
+    key_order_.emplace_back(OrderByType::ASC, key_expr);
+  }
+}
+
+bool MergeJoinExecutor::Advance(AbstractExecutor *child, const std::vector<const AbstractExpression *> &key_exprs,
+                                Tuple *tuple, std::vector<Value> *keys) {
+  RID rid;
+  while (child->Next(tuple, &rid)) {
+    keys->clear();
+    bool has_null = false;
+    for (const auto &expr : key_exprs) {
+      keys->emplace_back(expr->Evaluate(tuple, child->GetOutputSchema()));
+      has_null = has_null || keys->back().IsNull();
+    }
+    // NULL keys can never satisfy the equi-join.
+    if (!has_null) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  has_left_ = false;
+  has_right_ = Advance(right_executor_.get(), plan_->GetRightKeys(), &right_tuple_, &right_keys_);
+  run_.clear();
+  run_idx_ = 0;
+}
+
+bool MergeJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  while (true) {
+    if (!has_left_ || run_idx_ >= run_.size()) {
+      has_left_ = Advance(left_executor_.get(), plan_->GetLeftKeys(), &left_tuple_, &left_keys_);
+      if (!has_left_) {
+        return false;
+      }
+      run_idx_ = 0;
+      // Consecutive left tuples with the same key join the same run.
+      if (!run_.empty() && Compare(left_keys_, run_keys_) == 0) {
+        continue;
+      }
+
+      run_.clear();
+      while (has_right_ && Compare(right_keys_, left_keys_) < 0) {
+        has_right_ = Advance(right_executor_.get(), plan_->GetRightKeys(), &right_tuple_, &right_keys_);
+      }
+      if (!has_right_) {
+        // The right side is used up, so no later left tuple can match either.
+        return false;
+      }
+      if (Compare(right_keys_, left_keys_) > 0) {
+        continue;
+      }
+      run_keys_ = right_keys_;
+      while (has_right_ && Compare(right_keys_, run_keys_) == 0) {
+        // The run outlives the right child's next call, which may free right_tuple_.
+        run_.push_back(right_tuple_.Materialize());
+        has_right_ = Advance(right_executor_.get(), plan_->GetRightKeys(), &right_tuple_, &right_keys_);
+      }
+      continue;
+    }
+
+    const Tuple &right_tuple = run_[run_idx_++];
+    if (plan_->Predicate() != nullptr) {
+      // A NULL result, e.g. of a comparison with NULL, does not satisfy the predicate.
+      Value satisfied = plan_->Predicate()->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema);
+      if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+        continue;
+      }
+    }
+
+    const Schema *output_schema = plan_->OutputSchema();
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &col : output_schema->GetColumns()) {
+      values.push_back(col.GetExpr()->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema));
+    }
+    *tuple = Tuple(values, output_schema, &output_arena_);
+    *rid = right_tuple.GetRid();
+    return true;
+  }
+}
+
+}  // namespace bustub
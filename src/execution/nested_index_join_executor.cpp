@@ -12,14 +12,116 @@
 
 #include "execution/executors/nested_index_join_executor.h"
 
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "storage/table/tuple_view.h"
+
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void NestIndexJoinExecutor::Init() {
+  Catalog *catalog = exec_ctx_->GetCatalog();
+  inner_table_info_ = catalog->GetTable(plan_->GetInnerTableOid());
+  index_info_ = catalog->GetIndex(plan_->GetIndexName(), inner_table_info_->name_);
+
+  // The index can only answer equality probes: outer.col = inner.col, in either order.
+  auto predicate = dynamic_cast<const ComparisonExpression *>(plan_->Predicate());
+  if (predicate == nullptr || predicate->GetComparisonType() != ComparisonType::Equal ||
+      index_info_->index_->GetIndexColumnCount() != 1) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED, "Nested index join only supports single-column equi-joins.");
+  }
+  // The probe key is whichever side is not a column of the inner tuple, which is tuple 1 of the predicate.
+  auto is_inner_column = [](const AbstractExpression *expr) {
+    auto column = dynamic_cast<const ColumnValueExpression *>(expr);
+    return column != nullptr && column->GetTupleIdx() == 1;
+  };
+  bool left_is_inner = is_inner_column(predicate->GetChildAt(0));
+  if (left_is_inner == is_inner_column(predicate->GetChildAt(1))) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                    "Nested index join needs exactly one side of its predicate to be an inner column.");
+  }
+  outer_key_expr_ = predicate->GetChildAt(left_is_inner ? 1 : 0);
+
+  child_executor_->Init();
+  outer_batch_.clear();
+  inner_rids_.clear();
+  outer_idx_ = 0;
+  inner_idx_ = 0;
+}
+
+bool NestIndexJoinExecutor::FetchBatch() {
+  Index *index = index_info_->index_.get();
+  const Schema *key_schema = index->GetKeySchema();
+  TypeId key_type = key_schema->GetColumn(0).GetType();
+  outer_batch_.clear();
+  std::vector<Tuple> keys;
+  Tuple outer;
+  RID outer_rid;
+  while (outer_batch_.size() < BATCH_SIZE && child_executor_->Next(&outer, &outer_rid)) {
+    Value key = outer_key_expr_->Evaluate(&outer, plan_->OuterTableSchema());
+    // NULL keys can never satisfy the equi-join, so they are not probed for.
+    if (key.IsNull()) {
+      continue;
+    }
+    // The batch outlives the child's next call, which may free outer.
+    outer_batch_.push_back(outer.Materialize());
+    keys.emplace_back(std::vector<Value>{key.CastAs(key_type)}, key_schema);
+  }
+  if (outer_batch_.empty()) {
+    return false;
+  }
+  index->ScanKeys(keys, &inner_rids_, exec_ctx_->GetTransaction());
+
+  outer_idx_ = 0;
+  inner_idx_ = 0;
+  return true;
+}
+
+bool NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  const Schema *outer_schema = plan_->OuterTableSchema();
+  const Schema *inner_schema = plan_->InnerTableSchema();
+  while (true) {
+    if (outer_idx_ >= outer_batch_.size()) {
+      if (!FetchBatch()) {
+        return false;
+      }
+      continue;
+    }
+    if (inner_idx_ >= inner_rids_[outer_idx_].size()) {
+      outer_idx_++;
+      inner_idx_ = 0;
+      continue;
+    }
 
-void NestIndexJoinExecutor::Init() {}
+    const Tuple &outer = outer_batch_[outer_idx_];
+    // The inner tuple is read in place, and released once the output is projected from it.
+    TupleView inner_view;
+    bool fetched = inner_table_info_->table_->GetTupleView(inner_rids_[outer_idx_][inner_idx_++], &inner_view,
+                                                           exec_ctx_->GetTransaction());
+    if (!fetched) {
+      continue;
+    }
+    const Tuple &inner = inner_view.GetTuple();
+    // A NULL result, e.g. of a comparison with NULL, does not satisfy the predicate.
+    Value satisfied = plan_->Predicate()->EvaluateJoin(&outer, outer_schema, &inner, inner_schema);
+    if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+      continue;
+    }
 
-bool NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+    const Schema *output_schema = plan_->OutputSchema();
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &col : output_schema->GetColumns()) {
+      values.push_back(col.GetExpr()->EvaluateJoin(&outer, outer_schema, &inner, inner_schema));
+    }
+    *tuple = Tuple(values, output_schema, &output_arena_);
+    *rid = inner.GetRid();
+    return true;
+  }
+}
 
 }  // namespace bustub
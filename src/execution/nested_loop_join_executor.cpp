@@ -12,15 +12,60 @@
 
 #include "execution/executors/nested_loop_join_executor.h"
 
+#include <vector>
+
 namespace bustub {
 
 NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const NestedLoopJoinPlanNode *plan,
                                                std::unique_ptr<AbstractExecutor> &&left_executor,
                                                std::unique_ptr<AbstractExecutor> &&right_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+void NestedLoopJoinExecutor::Init() {
+  left_executor_->Init();
+  has_left_ = false;
+}
 
-void NestedLoopJoinExecutor::Init() {}
+bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  Tuple right_tuple;
+  RID right_rid;
+  while (true) {
+    if (!has_left_) {
+      RID left_rid;
+      if (!left_executor_->Next(&left_tuple_, &left_rid)) {
+        return false;
+      }
+      right_executor_->Init();
+      has_left_ = true;
+    }
+    if (!right_executor_->Next(&right_tuple, &right_rid)) {
+      has_left_ = false;
+      continue;
+    }
+    if (plan_->Predicate() != nullptr) {
+      // A NULL result, e.g. of a comparison with NULL, does not satisfy the predicate.
+      Value satisfied = plan_->Predicate()->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema);
+      if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+        continue;
+      }
+    }
 
-bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+    const Schema *output_schema = plan_->OutputSchema();
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &col : output_schema->GetColumns()) {
+      values.push_back(col.GetExpr()->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema));
+    }
+    *tuple = Tuple(values, output_schema, &output_arena_);
+    *rid = right_rid;
+    return true;
+  }
+}
 
 }  // namespace bustub
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_context.cpp
+//
+// Identification: src/execution/parallel_context.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/parallel_context.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+void PartitionExchange::Add(uint32_t producer, uint32_t partition, const Tuple &tuple) {
+  buffers_[producer][partition].push_back(tuple.Materialize());
+  buffered_bytes_[producer] += sizeof(Tuple) + tuple.GetLength();
+  if (buffered_bytes_[producer] > budget_) {
+    Spill(producer);
+  }
+}
+
+void PartitionExchange::Spill(uint32_t producer) {
+  auto &files = spilled_[producer];
+  if (files.empty()) {
+    for (uint32_t partition = 0; partition < buffers_[producer].size(); partition++) {
+      files.push_back(std::make_unique<TmpTupleFile>(bpm_));
+    }
+  }
+  for (uint32_t partition = 0; partition < buffers_[producer].size(); partition++) {
+    for (const auto &tuple : buffers_[producer][partition]) {
+      files[partition]->Append(tuple);
+    }
+    // Give the memory back too, not just the tuples.
+    buffers_[producer][partition] = std::vector<Tuple>();
+  }
+  buffered_bytes_[producer] = 0;
+}
+
+void PartitionExchange::Finish(uint32_t producer) {
+  for (auto &file : spilled_[producer]) {
+    file->Finish();
+  }
+}
+
+PartitionExchange::Reader::Reader(const PartitionExchange *exchange, uint32_t producer, uint32_t partition)
+    : buffer_(&exchange->buffers_[producer][partition]) {
+  if (!exchange->spilled_[producer].empty()) {
+    spilled_ = exchange->spilled_[producer][partition]->MakeReader();
+  }
+}
+
+const Tuple *PartitionExchange::Reader::Next() {
+  if (spilled_ != nullptr) {
+    if (spilled_->Next(&spilled_tuple_)) {
+      return &spilled_tuple_;
+    }
+    // Unpin the last spilled page now rather than with the reader.
+    spilled_.reset();
+  }
+  if (buffer_idx_ < buffer_->size()) {
+    return &(*buffer_)[buffer_idx_++];
+  }
+  return nullptr;
+}
+
+void ParallelContext::ArriveAndWait() {
+  std::unique_lock latch(latch_);
+  if (aborted_) {
+    throw Exception("The parallel plan was aborted.");
+  }
+  uint64_t generation = generation_;
+  if (++num_arrived_ == num_workers_) {
+    num_arrived_ = 0;
+    generation_++;
+    barrier_cv_.notify_all();
+    return;
+  }
+  barrier_cv_.wait(latch, [this, generation] { return aborted_ || generation_ != generation; });
+  if (generation_ == generation) {
+    throw Exception("The parallel plan was aborted.");
+  }
+}
+
+void ParallelContext::Abort() {
+  std::scoped_lock latch(latch_);
+  aborted_ = true;
+  barrier_cv_.notify_all();
+}
+
+}  // namespace bustub
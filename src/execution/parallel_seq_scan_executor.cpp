@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_seq_scan_executor.cpp
+//
+// Identification: src/execution/parallel_seq_scan_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include "execution/executors/parallel_seq_scan_executor.h"
+
+#include <utility>
+
+#include "common/exception.h"
+#include "storage/page/page_guard.h"
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+ParallelSeqScanExecutor::ParallelSeqScanExecutor(ExecutorContext *exec_ctx, const ParallelSeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+ParallelSeqScanExecutor::~ParallelSeqScanExecutor() { Stop(); }
+
+void ParallelSeqScanExecutor::Stop() {
+  if (queue_ != nullptr) {
+    queue_->Close();
+    queue_->WaitForProducers();
+  }
+}
+
+void ParallelSeqScanExecutor::Init() {
+  Stop();
+  BUSTUB_ASSERT(exec_ctx_->GetParallelContext() == nullptr, "ParallelSeqScan cannot run below a Gather.");
+  ThreadPool *thread_pool = exec_ctx_->GetThreadPool();
+  BUSTUB_ASSERT(thread_pool != nullptr, "ParallelSeqScan needs the thread pool of an ExecutionEngine.");
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
+  predicate_ = std::make_unique<CompiledPredicate>(plan_->GetPredicate(), &table_info_->schema_);
+  batch_.Clear();
+  batch_idx_ = 0;
+
+  uint32_t num_workers = plan_->GetNumWorkers();
+  if (num_workers == 0) {
+    num_workers = thread_pool->GetNumThreads();
+  }
+  dispenser_ = std::make_unique<PageRangeDispenser>(exec_ctx_->GetBufferPoolManager(),
+                                                    table_info_->table_->GetFirstPageId(), num_workers);
+  queue_ = std::make_unique<ExchangeQueue>(num_workers);
+  for (uint32_t i = 0; i < num_workers; i++) {
+    thread_pool->Submit([this, i] { Work(i); });
+  }
+}
+
+void ParallelSeqScanExecutor::ScanPage(page_id_t page_id, std::vector<Tuple> *matches, std::vector<RID> *rids) const {
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  auto guard = bpm->FetchPageRead(page_id);
+  if (!guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "ParallelSeqScanExecutor could not fetch a table page.");
+  }
+  auto page = guard.As<TablePage>();
+  const Schema *table_schema = &table_info_->schema_;
+  const Schema *output_schema = plan_->OutputSchema();
+  std::vector<Value> values;
+  values.reserve(output_schema->GetColumnCount());
+  matches->clear();
+  rids->clear();
+  // The tuples are read in place and projected straight out of the page, so only the output is copied.
+  Tuple raw;
+  RID rid;
+  for (bool found = page->GetFirstTupleRid(&rid); found;) {
+    if (page->GetTupleInPlace(rid, &raw, exec_ctx_->GetTransaction(), exec_ctx_->GetLockManager()) &&
+        predicate_->Evaluate(&raw)) {
+      values.clear();
+      for (const auto &col : output_schema->GetColumns()) {
+        values.push_back(col.GetExpr()->Evaluate(&raw, table_schema));
+      }
+      matches->emplace_back(values, output_schema);
+      rids->push_back(rid);
+    }
+    RID next_rid;
+    found = page->GetNextTupleRid(rid, &next_rid);
+    rid = next_rid;
+  }
+}
+
+void ParallelSeqScanExecutor::Work(uint32_t worker_id) {
+  std::vector<Tuple> matches;
+  std::vector<RID> rids;
+  TupleBatch batch;
+  try {
+    bool closed = false;
+    page_id_t page_id = dispenser_->Next(worker_id);
+    while (!closed && page_id != INVALID_PAGE_ID) {
+      // The page is released before any batch is pushed, so a slow consumer never holds up a page.
+      ScanPage(page_id, &matches, &rids);
+      for (size_t i = 0; i < matches.size(); i++) {
+        batch.Append(matches[i], rids[i]);
+        if (batch.IsFull()) {
+          closed = !queue_->Push(std::move(batch));
+          batch = TupleBatch();
+          if (closed) {
+            break;
+          }
+        }
+      }
+      page_id = closed ? INVALID_PAGE_ID : dispenser_->Next(worker_id);
+    }
+    if (!closed && !batch.IsEmpty()) {
+      queue_->Push(std::move(batch));
+    }
+  } catch (...) {
+    queue_->Fail(std::current_exception());
+  }
+  queue_->ProducerDone();
+}
+
+bool ParallelSeqScanExecutor::Next(Tuple *tuple, RID *rid) {
+  while (batch_idx_ >= batch_.Size()) {
+    batch_idx_ = 0;
+    if (!queue_->Pop(&batch_)) {
+      batch_.Clear();
+      return false;
+    }
+  }
+  *tuple = batch_.GetTuple(batch_idx_);
+  *rid = batch_.GetRid(batch_idx_);
+  batch_idx_++;
+  return true;
+}
+
+bool ParallelSeqScanExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  RID rid;
+  while (!batch->IsFull() && Next(&tuple, &rid)) {
+    batch->Append(tuple, rid);
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
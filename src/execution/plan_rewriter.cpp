@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_rewriter.cpp
+//
+// Identification: src/execution/plan_rewriter.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/plan_rewriter.h"
+
+#include <algorithm>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregate_plan.h"
+#include "execution/plans/top_n_plan.h"
+
+namespace bustub {
+
+const AbstractPlanNode *PlanRewriter::RewriteSortLimitAsTopN(const AbstractPlanNode *plan) {
+  if (plan->GetType() != PlanType::Limit) {
+    return plan;
+  }
+  auto limit_plan = dynamic_cast<const LimitPlanNode *>(plan);
+  if (limit_plan->GetChildPlan()->GetType() != PlanType::Sort) {
+    return plan;
+  }
+  auto sort_plan = dynamic_cast<const SortPlanNode *>(limit_plan->GetChildPlan());
+  plans_.push_back(std::make_unique<TopNPlanNode>(limit_plan->OutputSchema(), sort_plan->GetChildPlan(),
+                                                  sort_plan->GetOrderBys(), limit_plan->GetLimit(),
+                                                  limit_plan->GetOffset()));
+  return plans_.back().get();
+}
+
+bool PlanRewriter::IsIndexOrderedOn(const AbstractPlanNode *plan,
+                                    const std::vector<const AbstractExpression *> &key_exprs, Catalog *catalog) {
+  if (plan->GetType() != PlanType::IndexScan || key_exprs.empty()) {
+    return false;
+  }
+  IndexInfo *index_info = catalog->GetIndex(dynamic_cast<const IndexScanPlanNode *>(plan)->GetIndexOid());
+  const std::vector<uint32_t> &key_attrs = index_info->index_->GetKeyAttrs();
+  if (index_info->index_type_ != IndexType::BPlusTreeIndex || key_exprs.size() > key_attrs.size()) {
+    return false;
+  }
+  // Each key reads a column of the scan's output, which has to be one of the table columns the index leads with.
+  std::vector<bool> covered(key_exprs.size(), false);
+  for (const auto &key_expr : key_exprs) {
+    auto key_column = dynamic_cast<const ColumnValueExpression *>(key_expr);
+    if (key_column == nullptr) {
+      return false;
+    }
+    auto table_column = dynamic_cast<const ColumnValueExpression *>(
+        plan->OutputSchema()->GetColumn(key_column->GetColIdx()).GetExpr());
+    if (table_column == nullptr) {
+      return false;
+    }
+    auto prefix_end = key_attrs.begin() + key_exprs.size();
+    auto attr = std::find(key_attrs.begin(), prefix_end, table_column->GetColIdx());
+    if (attr == prefix_end) {
+      return false;
+    }
+    covered[attr - key_attrs.begin()] = true;
+  }
+  return std::all_of(covered.begin(), covered.end(), [](bool c) { return c; });
+}
+
+const AbstractPlanNode *PlanRewriter::RewriteJoinAsMergeJoin(const AbstractPlanNode *plan, Catalog *catalog) {
+  const AbstractExpression *left_key;
+  const AbstractExpression *right_key;
+  const AbstractExpression *predicate;
+  if (plan->GetType() == PlanType::HashJoin) {
+    auto hash_join_plan = dynamic_cast<const HashJoinPlanNode *>(plan);
+    if (hash_join_plan->GetLeftKeys().size() != 1) {
+      return plan;
+    }
+    left_key = hash_join_plan->GetLeftKeys()[0];
+    right_key = hash_join_plan->GetRightKeys()[0];
+    predicate = hash_join_plan->Predicate();
+  } else if (plan->GetType() == PlanType::NestedLoopJoin) {
+    auto comparison = dynamic_cast<const ComparisonExpression *>(
+        dynamic_cast<const NestedLoopJoinPlanNode *>(plan)->Predicate());
+    if (comparison == nullptr || comparison->GetComparisonType() != ComparisonType::Equal) {
+      return plan;
+    }
+    auto lhs = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0));
+    auto rhs = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1));
+    if (lhs == nullptr || rhs == nullptr || lhs->GetTupleIdx() == rhs->GetTupleIdx()) {
+      return plan;
+    }
+    left_key = lhs->GetTupleIdx() == 0 ? lhs : rhs;
+    right_key = lhs->GetTupleIdx() == 0 ? rhs : lhs;
+    // The merge only pairs up equal keys, so the equality needs no rechecking.
+    predicate = nullptr;
+  } else {
+    return plan;
+  }
+
+  const AbstractPlanNode *left = plan->GetChildAt(0);
+  const AbstractPlanNode *right = plan->GetChildAt(1);
+  if (!IsIndexOrderedOn(left, {left_key}, catalog) || !IsIndexOrderedOn(right, {right_key}, catalog)) {
+    return plan;
+  }
+  plans_.push_back(std::make_unique<MergeJoinPlanNode>(plan->OutputSchema(),
+                                                       std::vector<const AbstractPlanNode *>{left, right},
+                                                       std::vector<const AbstractExpression *>{left_key},
+                                                       std::vector<const AbstractExpression *>{right_key}, predicate));
+  return plans_.back().get();
+}
+
+const AbstractPlanNode *PlanRewriter::RewriteAggregationAsStreaming(const AbstractPlanNode *plan, Catalog *catalog) {
+  if (plan->GetType() != PlanType::Aggregation) {
+    return plan;
+  }
+  auto agg_plan = dynamic_cast<const AggregationPlanNode *>(plan);
+  if (!IsIndexOrderedOn(agg_plan->GetChildPlan(), agg_plan->GetGroupBys(), catalog)) {
+    return plan;
+  }
+  plans_.push_back(std::make_unique<StreamingAggregatePlanNode>(
+      agg_plan->OutputSchema(), agg_plan->GetChildPlan(), agg_plan->GetHaving(),
+      std::vector<const AbstractExpression *>(agg_plan->GetGroupBys()),
+      std::vector<const AbstractExpression *>(agg_plan->GetAggregates()),
+      std::vector<AggregationType>(agg_plan->GetAggregateTypes())));
+  return plans_.back().get();
+}
+
+}  // namespace bustub
@@ -1,22 +1,165 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// seq_scan_executor.cpp
-//
-// Identification: src/execution/seq_scan_executor.cpp
-//
-// Copyright (c) 2015-19, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include "execution/executors/seq_scan_executor.h"
-
-namespace bustub {
-
-SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : AbstractExecutor(exec_ctx) {}
-
-void SeqScanExecutor::Init() {}
-
-bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// seq_scan_executor.cpp
+//
+// Identification: src/execution/seq_scan_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include "execution/executors/seq_scan_executor.h"
+
+#include <limits>
+#include <vector>
+
+#include "common/exception.h"
+#include "execution/simd_filter.h"
+#include "storage/page/page_guard.h"
+
+namespace bustub {
+
+SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void SeqScanExecutor::Init() {
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
+  predicate_ = std::make_unique<CompiledPredicate>(plan_->GetPredicate(), &table_info_->schema_);
+  filter_pages_ = CanFilterPages();
+  page_matches_.clear();
+  page_rids_.clear();
+  match_idx_ = 0;
+  dispenser_.reset();
+  ParallelContext *parallel_ctx = exec_ctx_->GetParallelContext();
+  if (parallel_ctx != nullptr) {
+    // Below a Gather, the workers' scans share out the pages of the table.
+    dispenser_ = parallel_ctx->GetShared<PageRangeDispenser>(plan_, [this, parallel_ctx] {
+      return std::make_shared<PageRangeDispenser>(exec_ctx_->GetBufferPoolManager(),
+                                                  table_info_->table_->GetFirstPageId(), parallel_ctx->GetNumWorkers());
+    });
+  }
+  next_page_id_ = table_info_->table_->GetFirstPageId();
+}
+
+bool SeqScanExecutor::CanFilterPages() const {
+  const CompiledPredicate::ColumnComparison *comparison = predicate_->GetColumnComparison();
+  if (comparison == nullptr) {
+    return false;
+  }
+  switch (comparison->column_type_) {
+    case TypeId::INTEGER:
+      return !comparison->as_decimal_ && comparison->integer_constant_ >= std::numeric_limits<int32_t>::min() &&
+             comparison->integer_constant_ <= std::numeric_limits<int32_t>::max();
+    case TypeId::BIGINT:
+      return !comparison->as_decimal_;
+    case TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+uint32_t SeqScanExecutor::FilterColumn(const TablePage *page, T constant) {
+  std::vector<T> values;
+  page->GatherColumn(predicate_->GetColumnComparison()->column_offset_, &values, &slots_);
+  selection_.resize(values.size());
+  return SimdFilter::Filter(values.data(), values.size(), predicate_->GetColumnComparison()->comp_type_, constant,
+                            selection_.data());
+}
+
+bool SeqScanExecutor::ScanNextPage() {
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  const CompiledPredicate::ColumnComparison *comparison = predicate_->GetColumnComparison();
+  page_matches_.clear();
+  page_rids_.clear();
+  match_idx_ = 0;
+  output_arena_.Reset();
+  std::vector<Value> values;
+  values.reserve(plan_->OutputSchema()->GetColumnCount());
+  // The tuples are read in place and projected straight out of the page, so only the output is copied.
+  Tuple raw;
+  auto emit = [this, &values](const Tuple &match) {
+    page_matches_.emplace_back();
+    Project(match, &values, &page_matches_.back());
+    page_rids_.push_back(match.GetRid());
+  };
+  while (page_matches_.empty()) {
+    page_id_t page_id = dispenser_ != nullptr ? dispenser_->Next(exec_ctx_->GetWorkerId()) : next_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      break;
+    }
+    auto guard = bpm->FetchPageRead(page_id);
+    if (!guard.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "SeqScanExecutor could not fetch a table page.");
+    }
+    auto page = guard.As<TablePage>();
+    if (filter_pages_) {
+      uint32_t num_selected;
+      switch (comparison->column_type_) {
+        case TypeId::INTEGER:
+          num_selected = FilterColumn(page, static_cast<int32_t>(comparison->integer_constant_));
+          break;
+        case TypeId::BIGINT:
+          num_selected = FilterColumn(page, comparison->integer_constant_);
+          break;
+        default:
+          num_selected = FilterColumn(page, comparison->decimal_constant_);
+          break;
+      }
+      // Only the tuples that passed the filter are read.
+      for (uint32_t i = 0; i < num_selected; i++) {
+        if (page->GetTupleInPlace(RID(page_id, slots_[selection_[i]]), &raw, exec_ctx_->GetTransaction(),
+                                  exec_ctx_->GetLockManager())) {
+          emit(raw);
+        }
+      }
+    } else {
+      RID rid;
+      for (bool found = page->GetFirstTupleRid(&rid); found;) {
+        if (page->GetTupleInPlace(rid, &raw, exec_ctx_->GetTransaction(), exec_ctx_->GetLockManager()) &&
+            predicate_->Evaluate(&raw)) {
+          emit(raw);
+        }
+        RID next_rid;
+        found = page->GetNextTupleRid(rid, &next_rid);
+        rid = next_rid;
+      }
+    }
+    next_page_id_ = page->GetNextPageId();
+  }
+  return !page_matches_.empty();
+}
+
+void SeqScanExecutor::Project(const Tuple &raw, std::vector<Value> *values, Tuple *tuple) {
+  const Schema *table_schema = &table_info_->schema_;
+  const Schema *output_schema = plan_->OutputSchema();
+  values->clear();
+  for (const auto &col : output_schema->GetColumns()) {
+    values->push_back(col.GetExpr()->Evaluate(&raw, table_schema));
+  }
+  *tuple = Tuple(*values, output_schema, &output_arena_);
+}
+
+bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) {
+  if (match_idx_ >= page_matches_.size() && !ScanNextPage()) {
+    return false;
+  }
+  *tuple = page_matches_[match_idx_];
+  *rid = page_rids_[match_idx_];
+  match_idx_++;
+  return true;
+}
+
+bool SeqScanExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  while (!batch->IsFull() && (match_idx_ < page_matches_.size() || ScanNextPage())) {
+    // The batch may span pages, and scanning a page frees the matches of the last one; the batch keeps copies.
+    batch->Append(Tuple(page_matches_[match_idx_], batch->GetArena()), page_rids_[match_idx_]);
+    match_idx_++;
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// simd_filter.cpp
+//
+// Identification: src/execution/simd_filter.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/simd_filter.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <type_traits>
+
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+template <typename T>
+bool IsNullValue(T value) {
+  if constexpr (std::is_same_v<T, int32_t>) {
+    return value == BUSTUB_INT32_NULL;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return value == BUSTUB_INT64_NULL;
+  } else {
+    return value <= BUSTUB_DECIMAL_NULL;
+  }
+}
+
+template <ComparisonType Cmp, typename T>
+bool Compare(T value, T constant) {
+  if constexpr (Cmp == ComparisonType::Equal) {
+    return value == constant;
+  } else if constexpr (Cmp == ComparisonType::NotEqual) {
+    return value != constant;
+  } else if constexpr (Cmp == ComparisonType::LessThan) {
+    return value < constant;
+  } else if constexpr (Cmp == ComparisonType::LessThanOrEqual) {
+    return value <= constant;
+  } else if constexpr (Cmp == ComparisonType::GreaterThan) {
+    return value > constant;
+  } else {
+    return value >= constant;
+  }
+}
+
+/** Filters values[begin, count), appending to a selection that already holds num_selected entries. */
+template <ComparisonType Cmp, typename T>
+uint32_t ScalarFilter(const T *values, uint32_t begin, uint32_t count, T constant, uint32_t *selection,
+                      uint32_t num_selected) {
+  for (uint32_t i = begin; i < count; i++) {
+    // Always write the position and only advance past it on a match, so selectivity does not cause mispredictions.
+    selection[num_selected] = i;
+    num_selected += static_cast<uint32_t>(!IsNullValue(values[i]) && Compare<Cmp>(values[i], constant));
+  }
+  return num_selected;
+}
+
+#ifdef __AVX2__
+/** Appends the positions of the lanes set in mask, offset by base, to the selection. */
+inline uint32_t AppendLanes(uint32_t mask, uint32_t base, uint32_t *selection, uint32_t num_selected) {
+  while (mask != 0) {
+    selection[num_selected++] = base + __builtin_ctz(mask);
+    mask &= mask - 1;
+  }
+  return num_selected;
+}
+
+/**
+ * Builds the lane mask for integer lanes. AVX2 only has equality and greater-than, so the other comparisons are
+ * derived from them; NULL is the type's minimum, hence a lane is not NULL exactly when it is greater than NULL.
+ */
+template <ComparisonType Cmp, typename CmpEq, typename CmpGt>
+__m256i IntegerLanes(__m256i v, __m256i c, __m256i nulls, CmpEq cmp_eq, CmpGt cmp_gt) {
+  __m256i not_null = cmp_gt(v, nulls);
+  if constexpr (Cmp == ComparisonType::Equal) {
+    return _mm256_and_si256(cmp_eq(v, c), not_null);
+  } else if constexpr (Cmp == ComparisonType::NotEqual) {
+    return _mm256_andnot_si256(cmp_eq(v, c), not_null);
+  } else if constexpr (Cmp == ComparisonType::LessThan) {
+    return _mm256_and_si256(cmp_gt(c, v), not_null);
+  } else if constexpr (Cmp == ComparisonType::LessThanOrEqual) {
+    return _mm256_andnot_si256(cmp_gt(v, c), not_null);
+  } else if constexpr (Cmp == ComparisonType::GreaterThan) {
+    return _mm256_and_si256(cmp_gt(v, c), not_null);
+  } else {
+    return _mm256_andnot_si256(cmp_gt(c, v), not_null);
+  }
+}
+
+template <ComparisonType Cmp>
+uint32_t VectorFilter(const int32_t *values, uint32_t count, int32_t constant, uint32_t *selection) {
+  const __m256i c = _mm256_set1_epi32(constant);
+  const __m256i nulls = _mm256_set1_epi32(BUSTUB_INT32_NULL);
+  auto cmp_eq = [](__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); };
+  auto cmp_gt = [](__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); };
+  uint32_t num_selected = 0;
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    __m256i lanes = IntegerLanes<Cmp>(v, c, nulls, cmp_eq, cmp_gt);
+    auto mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(lanes)));
+    num_selected = AppendLanes(mask, i, selection, num_selected);
+  }
+  return ScalarFilter<Cmp>(values, i, count, constant, selection, num_selected);
+}
+
+template <ComparisonType Cmp>
+uint32_t VectorFilter(const int64_t *values, uint32_t count, int64_t constant, uint32_t *selection) {
+  const __m256i c = _mm256_set1_epi64x(constant);
+  const __m256i nulls = _mm256_set1_epi64x(BUSTUB_INT64_NULL);
+  auto cmp_eq = [](__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); };
+  auto cmp_gt = [](__m256i a, __m256i b) { return _mm256_cmpgt_epi64(a, b); };
+  uint32_t num_selected = 0;
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    __m256i lanes = IntegerLanes<Cmp>(v, c, nulls, cmp_eq, cmp_gt);
+    auto mask = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(lanes)));
+    num_selected = AppendLanes(mask, i, selection, num_selected);
+  }
+  return ScalarFilter<Cmp>(values, i, count, constant, selection, num_selected);
+}
+
+template <ComparisonType Cmp>
+uint32_t VectorFilter(const double *values, uint32_t count, double constant, uint32_t *selection) {
+  // The predicates match the scalar operators, including their behavior on unordered operands.
+  constexpr int predicate = Cmp == ComparisonType::Equal                ? _CMP_EQ_OQ
+                            : Cmp == ComparisonType::NotEqual           ? _CMP_NEQ_UQ
+                            : Cmp == ComparisonType::LessThan           ? _CMP_LT_OQ
+                            : Cmp == ComparisonType::LessThanOrEqual    ? _CMP_LE_OQ
+                            : Cmp == ComparisonType::GreaterThan        ? _CMP_GT_OQ
+                                                                        : _CMP_GE_OQ;
+  const __m256d c = _mm256_set1_pd(constant);
+  const __m256d nulls = _mm256_set1_pd(BUSTUB_DECIMAL_NULL);
+  uint32_t num_selected = 0;
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256d v = _mm256_loadu_pd(values + i);
+    __m256d lanes = _mm256_and_pd(_mm256_cmp_pd(v, c, predicate), _mm256_cmp_pd(v, nulls, _CMP_NLE_UQ));
+    num_selected = AppendLanes(static_cast<uint32_t>(_mm256_movemask_pd(lanes)), i, selection, num_selected);
+  }
+  return ScalarFilter<Cmp>(values, i, count, constant, selection, num_selected);
+}
+#else
+template <ComparisonType Cmp, typename T>
+uint32_t VectorFilter(const T *values, uint32_t count, T constant, uint32_t *selection) {
+  return ScalarFilter<Cmp>(values, 0, count, constant, selection, 0);
+}
+#endif
+
+template <typename T>
+uint32_t Dispatch(const T *values, uint32_t count, ComparisonType comp_type, T constant, uint32_t *selection) {
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return VectorFilter<ComparisonType::Equal>(values, count, constant, selection);
+    case ComparisonType::NotEqual:
+      return VectorFilter<ComparisonType::NotEqual>(values, count, constant, selection);
+    case ComparisonType::LessThan:
+      return VectorFilter<ComparisonType::LessThan>(values, count, constant, selection);
+    case ComparisonType::LessThanOrEqual:
+      return VectorFilter<ComparisonType::LessThanOrEqual>(values, count, constant, selection);
+    case ComparisonType::GreaterThan:
+      return VectorFilter<ComparisonType::GreaterThan>(values, count, constant, selection);
+    case ComparisonType::GreaterThanOrEqual:
+    default:
+      return VectorFilter<ComparisonType::GreaterThanOrEqual>(values, count, constant, selection);
+  }
+}
+
+}  // namespace
+
+uint32_t SimdFilter::Filter(const int32_t *values, uint32_t count, ComparisonType comp_type, int32_t constant,
+                            uint32_t *selection) {
+  return Dispatch(values, count, comp_type, constant, selection);
+}
+
+uint32_t SimdFilter::Filter(const int64_t *values, uint32_t count, ComparisonType comp_type, int64_t constant,
+                            uint32_t *selection) {
+  return Dispatch(values, count, comp_type, constant, selection);
+}
+
+uint32_t SimdFilter::Filter(const double *values, uint32_t count, ComparisonType comp_type, double constant,
+                            uint32_t *selection) {
+  return Dispatch(values, count, comp_type, constant, selection);
+}
+
+}  // namespace bustub
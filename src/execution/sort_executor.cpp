@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.cpp
+//
+// Identification: src/execution/sort_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/sort_executor.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+SortExecutor::SortEntry SortExecutor::MakeEntry(Tuple &&tuple) {
+  std::vector<Value> keys;
+  keys.reserve(plan_->GetOrderBys().size());
+  for (const auto &order_by : plan_->GetOrderBys()) {
+    keys.emplace_back(order_by.second->Evaluate(&tuple, child_->GetOutputSchema()));
+  }
+  return {std::move(keys), std::move(tuple)};
+}
+
+size_t SortExecutor::Footprint(const SortEntry &entry) const {
+  return sizeof(SortEntry) + entry.keys_.size() * sizeof(Value) + entry.tuple_.GetLength();
+}
+
+void SortExecutor::SpillRun() {
+  const auto &order_bys = plan_->GetOrderBys();
+  std::stable_sort(entries_.begin(), entries_.end(), [&order_bys](const SortEntry &a, const SortEntry &b) {
+    return CompareSortKeys(order_bys, a.keys_, b.keys_) < 0;
+  });
+  auto run = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : entries_) {
+    run->Append(entry.tuple_);
+  }
+  run->Finish();
+  runs_.push_back(std::move(run));
+  entries_.clear();
+  entries_bytes_ = 0;
+}
+
+void SortExecutor::Init() {
+  entries_.clear();
+  entries_bytes_ = 0;
+  entry_idx_ = 0;
+  sources_.clear();
+  merging_.clear();
+  runs_.clear();
+  tree_.clear();
+
+  size_t budget = exec_ctx_->GetMemoryBudget();
+  child_->Init();
+  Tuple tuple;
+  RID rid;
+  while (child_->Next(&tuple, &rid)) {
+    // The entries outlive the child's next call, which may free tuple.
+    entries_.push_back(MakeEntry(tuple.Materialize()));
+    entries_bytes_ += Footprint(entries_.back());
+    if (entries_bytes_ > budget) {
+      SpillRun();
+    }
+  }
+
+  if (runs_.empty()) {
+    const auto &order_bys = plan_->GetOrderBys();
+    std::stable_sort(entries_.begin(), entries_.end(), [&order_bys](const SortEntry &a, const SortEntry &b) {
+      return CompareSortKeys(order_bys, a.keys_, b.keys_) < 0;
+    });
+    return;
+  }
+  if (!entries_.empty()) {
+    SpillRun();
+  }
+
+  // Every merged run keeps a page pinned; half the buffer pool leaves the rest of the query room to work.
+  size_t fan_in = std::max<size_t>(2, exec_ctx_->GetBufferPoolManager()->GetPoolSize() / 2);
+  while (runs_.size() > fan_in) {
+    // Each pass merges consecutive runs and keeps the merged runs in the order of their inputs, since ties go to the
+    // older run.
+    std::deque<std::unique_ptr<TmpTupleFile>> merged_runs;
+    while (!runs_.empty()) {
+      std::vector<std::unique_ptr<TmpTupleFile>> group;
+      while (group.size() < fan_in && !runs_.empty()) {
+        group.push_back(std::move(runs_.front()));
+        runs_.pop_front();
+      }
+      if (group.size() == 1) {
+        merged_runs.push_back(std::move(group.front()));
+        continue;
+      }
+      StartMerge(std::move(group));
+      auto merged = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+      while (NextMerged(&tuple)) {
+        merged->Append(tuple);
+      }
+      merged->Finish();
+      merged_runs.push_back(std::move(merged));
+    }
+    runs_ = std::move(merged_runs);
+  }
+  StartMerge({std::make_move_iterator(runs_.begin()), std::make_move_iterator(runs_.end())});
+  runs_.clear();
+}
+
+void SortExecutor::Advance(MergeSource *source) {
+  Tuple tuple;
+  source->exhausted_ = !source->reader_->Next(&tuple);
+  if (!source->exhausted_) {
+    source->entry_ = MakeEntry(std::move(tuple));
+  }
+}
+
+bool SortExecutor::Beats(size_t a, size_t b) const {
+  if (sources_[a].exhausted_ || sources_[b].exhausted_) {
+    return !sources_[a].exhausted_;
+  }
+  int cmp = CompareSortKeys(plan_->GetOrderBys(), sources_[a].entry_.keys_, sources_[b].entry_.keys_);
+  // Ties go to the older run, which keeps the sort stable.
+  return cmp < 0 || (cmp == 0 && a < b);
+}
+
+size_t SortExecutor::BuildTree(size_t node) {
+  // Nodes 1 .. k-1 are matches, nodes k .. 2k-1 are the sources.
+  size_t k = sources_.size();
+  if (node >= k) {
+    return node - k;
+  }
+  size_t left = BuildTree(2 * node);
+  size_t right = BuildTree(2 * node + 1);
+  bool left_wins = Beats(left, right);
+  tree_[node] = left_wins ? right : left;
+  return left_wins ? left : right;
+}
+
+void SortExecutor::StartMerge(std::vector<std::unique_ptr<TmpTupleFile>> &&runs) {
+  sources_.clear();
+  merging_ = std::move(runs);
+  sources_.resize(merging_.size());
+  for (size_t i = 0; i < merging_.size(); i++) {
+    sources_[i].reader_ = merging_[i]->MakeReader();
+    Advance(&sources_[i]);
+  }
+  tree_.assign(sources_.size(), 0);
+  tree_[0] = BuildTree(1);
+}
+
+bool SortExecutor::NextMerged(Tuple *tuple) {
+  size_t winner = tree_[0];
+  if (sources_[winner].exhausted_) {
+    return false;
+  }
+  *tuple = std::move(sources_[winner].entry_.tuple_);
+  Advance(&sources_[winner]);
+
+  // Replay the winner's path to the root; only its matches can have changed.
+  for (size_t node = (winner + sources_.size()) / 2; node > 0; node /= 2) {
+    if (Beats(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+  return true;
+}
+
+bool SortExecutor::Next(Tuple *tuple, RID *rid) {
+  if (sources_.empty()) {
+    if (entry_idx_ >= entries_.size()) {
+      return false;
+    }
+    *tuple = entries_[entry_idx_++].tuple_;
+  } else if (!NextMerged(tuple)) {
+    return false;
+  }
+  *rid = tuple->GetRid();
+  return true;
+}
+
+}  // namespace bustub
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregate_executor.cpp
+//
+// Identification: src/execution/streaming_aggregate_executor.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/streaming_aggregate_executor.h"
+
+namespace bustub {
+
+StreamingAggregateExecutor::StreamingAggregateExecutor(ExecutorContext *exec_ctx,
+                                                       const StreamingAggregatePlanNode *plan,
+                                                       std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)), group_(MakeTable()) {}
+
+AggregationHashTable StreamingAggregateExecutor::MakeTable() const {
+  std::vector<TypeId> key_types;
+  for (const auto &expr : plan_->GetGroupBys()) {
+    key_types.push_back(expr->GetReturnType());
+  }
+  return AggregationHashTable(std::move(key_types), plan_->GetAggregateTypes());
+}
+
+void StreamingAggregateExecutor::Init() {
+  // Each worker below a Gather would only see part of every group.
+  BUSTUB_ASSERT(exec_ctx_->GetParallelContext() == nullptr, "StreamingAggregate cannot run below a Gather.");
+  child_->Init();
+  batch_.Clear();
+  batch_idx_ = 0;
+  child_done_ = false;
+  has_group_ = false;
+}
+
+void StreamingAggregateExecutor::MakeKey(const Tuple *tuple) {
+  next_key_.clear();
+  for (const auto &expr : plan_->GetGroupBys()) {
+    AggregationHashTable::AppendKey(expr->Evaluate(tuple, child_->GetOutputSchema()), &next_key_);
+  }
+}
+
+void StreamingAggregateExecutor::StartGroup() {
+  key_.swap(next_key_);
+  // The table only ever holds the current group, so the key needs no hash.
+  group_.ResetToGroup(key_, 0);
+  has_group_ = true;
+}
+
+void StreamingAggregateExecutor::CombineTuple(const Tuple *tuple) {
+  input_.clear();
+  for (const auto &expr : plan_->GetAggregates()) {
+    input_.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+  }
+  group_.Combine(0, input_);
+}
+
+bool StreamingAggregateExecutor::FinishGroup(Tuple *tuple, Arena *arena) {
+  has_group_ = false;
+  std::vector<Value> group_bys = group_.GetGroupBys(0);
+  std::vector<Value> aggregates = group_.GetAggregates(0);
+  const AbstractExpression *having = plan_->GetHaving();
+  if (having != nullptr) {
+    // A NULL result, e.g. of a comparison with NULL, does not satisfy HAVING.
+    Value satisfied = having->EvaluateAggregate(group_bys, aggregates);
+    if (satisfied.IsNull() || !satisfied.GetAs<bool>()) {
+      return false;
+    }
+  }
+  const Schema *output_schema = plan_->OutputSchema();
+  std::vector<Value> values;
+  values.reserve(output_schema->GetColumnCount());
+  for (const auto &col : output_schema->GetColumns()) {
+    values.push_back(col.GetExpr()->EvaluateAggregate(group_bys, aggregates));
+  }
+  *tuple = Tuple(values, output_schema, arena);
+  return true;
+}
+
+bool StreamingAggregateExecutor::NextGroup(Tuple *tuple, Arena *arena) {
+  while (true) {
+    if (batch_idx_ >= batch_.Size()) {
+      batch_idx_ = 0;
+      if (child_done_ || !child_->NextBatch(&batch_)) {
+        // The last group ends with the input.
+        child_done_ = true;
+        batch_.Clear();
+        if (!has_group_) {
+          return false;
+        }
+        if (FinishGroup(tuple, arena)) {
+          return true;
+        }
+        continue;
+      }
+    }
+
+    const Tuple *child_tuple = &batch_.GetTuple(batch_idx_++);
+    MakeKey(child_tuple);
+    if (has_group_ && next_key_ == key_) {
+      CombineTuple(child_tuple);
+      continue;
+    }
+    // A new key ends the current group, which is output once the tuple has started the next one.
+    bool finished = has_group_ && FinishGroup(tuple, arena);
+    StartGroup();
+    CombineTuple(child_tuple);
+    if (finished) {
+      return true;
+    }
+  }
+}
+
+bool StreamingAggregateExecutor::Next(Tuple *tuple, RID *rid) {
+  output_arena_.Reset();
+  if (!NextGroup(tuple, &output_arena_)) {
+    return false;
+  }
+  *rid = RID();
+  return true;
+}
+
+bool StreamingAggregateExecutor::NextBatch(TupleBatch *batch) {
+  batch->Clear();
+  Tuple tuple;
+  while (!batch->IsFull() && NextGroup(&tuple, batch->GetArena())) {
+    batch->Append(tuple, RID());
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_executor.cpp
+//
+// Identification: src/execution/top_n_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/top_n_executor.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+bool TopNExecutor::Before(const HeapEntry &a, const HeapEntry &b) const {
+  int cmp = CompareSortKeys(plan_->GetOrderBys(), a.keys_, b.keys_);
+  return cmp < 0 || (cmp == 0 && a.seq_ < b.seq_);
+}
+
+void TopNExecutor::Init() {
+  top_.clear();
+  top_idx_ = 0;
+  size_t n = plan_->GetOffset() + plan_->GetLimit();
+  if (plan_->GetLimit() == 0) {
+    return;
+  }
+
+  // top_ is a heap whose front is the entry that sorts last, the first to be displaced.
+  auto before = [this](const HeapEntry &a, const HeapEntry &b) { return Before(a, b); };
+  child_->Init();
+  Tuple tuple;
+  RID rid;
+  std::vector<Value> keys;
+  for (size_t seq = 0; child_->Next(&tuple, &rid); seq++) {
+    keys.clear();
+    for (const auto &order_by : plan_->GetOrderBys()) {
+      keys.emplace_back(order_by.second->Evaluate(&tuple, child_->GetOutputSchema()));
+    }
+    if (top_.size() == n) {
+      // A later tuple never displaces an equal one, so a tie with the front is not a candidate either.
+      if (CompareSortKeys(plan_->GetOrderBys(), keys, top_.front().keys_) >= 0) {
+        continue;
+      }
+      std::pop_heap(top_.begin(), top_.end(), before);
+      top_.pop_back();
+    }
+    // The heap outlives the child's next call, which may free tuple.
+    top_.push_back({keys, seq, tuple.Materialize()});
+    std::push_heap(top_.begin(), top_.end(), before);
+  }
+
+  std::sort_heap(top_.begin(), top_.end(), before);
+  top_idx_ = plan_->GetOffset();
+}
+
+bool TopNExecutor::Next(Tuple *tuple, RID *rid) {
+  if (top_idx_ >= top_.size()) {
+    return false;
+  }
+  *tuple = top_[top_idx_++].tuple_;
+  *rid = tuple->GetRid();
+  return true;
+}
+
+}  // namespace bustub
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
 #include <list>
 #include <mutex>  // NOLINT
 #include <unordered_map>
@@ -23,6 +27,9 @@
 
 namespace bustub {
 
+class ReadPageGuard;
+class WritePageGuard;
+
 /**
  * BufferPoolManager reads disk pages to and from its internal buffer pool.
  */
@@ -91,6 +98,53 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
+  /**
+   * Fetches a page and read latches it.
+   * @param page_id id of page to be fetched
+   * @return a guard that unlatches and unpins the page when it goes away, empty if the page could not be fetched
+   */
+  ReadPageGuard FetchPageRead(page_id_t page_id);
+
+  /**
+   * Fetches a page and write latches it.
+   * @param page_id id of page to be fetched
+   * @return a guard that unlatches and unpins the page when it goes away, empty if the page could not be fetched
+   */
+  WritePageGuard FetchPageWrite(page_id_t page_id);
+
+  /**
+   * Creates a new page and write latches it.
+   * @param[out] page_id id of created page
+   * @return a guard that unlatches and unpins the page when it goes away, empty if no new page could be created
+   */
+  WritePageGuard NewPageGuarded(page_id_t *page_id);
+
+  /** How long the page guards held their pins. */
+  struct PinStats {
+    /** The number of pins released by guards. */
+    uint64_t num_pins_;
+    /** The total and the longest time a guard held a pin. */
+    std::chrono::nanoseconds total_;
+    std::chrono::nanoseconds max_;
+  };
+
+  /** Records that a page guard released a pin it held for the given time. */
+  void RecordPinDuration(std::chrono::steady_clock::duration duration) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    num_guarded_pins_.fetch_add(1, std::memory_order_relaxed);
+    guarded_pin_ns_.fetch_add(ns, std::memory_order_relaxed);
+    int64_t max = max_guarded_pin_ns_.load(std::memory_order_relaxed);
+    while (ns > max && !max_guarded_pin_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /** @return the pin durations recorded by the page guards so far */
+  PinStats GetPinStats() const {
+    return {num_guarded_pins_.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds(guarded_pin_ns_.load(std::memory_order_relaxed)),
+            std::chrono::nanoseconds(max_guarded_pin_ns_.load(std::memory_order_relaxed))};
+  }
+
   /** @return pointer to all the pages in the buffer pool */
   Page *GetPages() { return pages_; }
 
@@ -168,5 +222,9 @@ class BufferPoolManager {
   std::list<frame_id_t> free_list_;
   /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
   std::mutex latch_;
+  /** The pin durations recorded by the page guards, for GetPinStats. */
+  std::atomic<uint64_t> num_guarded_pins_{0};
+  std::atomic<int64_t> guarded_pin_ns_{0};
+  std::atomic<int64_t> max_guarded_pin_ns_{0};
 };
 }  // namespace bustub
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -10,6 +12,7 @@
 #include "catalog/schema.h"
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/index.h"
+#include "storage/index/linear_probe_hash_table_index.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -33,24 +36,30 @@ struct TableMetadata {
   table_oid_t oid_;
 };
 
+/** IndexType selects the data structure behind an index created through the catalog. */
+enum class IndexType { BPlusTreeIndex, HashTableIndex };
+
 /**
  * Metadata about a index
  */
 struct IndexInfo {
   IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
-            std::string table_name, size_t key_size)
+            std::string table_name, size_t key_size, IndexType index_type = IndexType::BPlusTreeIndex)
       : key_schema_(std::move(key_schema)),
         name_(std::move(name)),
         index_(std::move(index)),
         index_oid_(index_oid),
         table_name_(std::move(table_name)),
-        key_size_(key_size) {}
+        key_size_(key_size),
+        index_type_(index_type) {}
   Schema key_schema_;
   std::string name_;
   std::unique_ptr<Index> index_;
   index_oid_t index_oid_;
   std::string table_name_;
   const size_t key_size_;
+  /** Only B+ tree indexes return their entries in key order. */
+  const IndexType index_type_;
 };
 
 /**
@@ -77,14 +86,30 @@ class Catalog {
    */
   TableMetadata *CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema) {
     BUSTUB_ASSERT(names_.count(table_name) == 0, "Table names should be unique!");
-    return nullptr;
+    table_oid_t oid = next_table_oid_++;
+    auto table = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, txn);
+    tables_[oid] = std::make_unique<TableMetadata>(schema, table_name, std::move(table), oid);
+    names_[table_name] = oid;
+    return tables_[oid].get();
   }
 
   /** @return table metadata by name */
-  TableMetadata *GetTable(const std::string &table_name) { return nullptr; }
+  TableMetadata *GetTable(const std::string &table_name) {
+    auto it = names_.find(table_name);
+    if (it == names_.end()) {
+      throw std::out_of_range("Table " + table_name + " does not exist.");
+    }
+    return GetTable(it->second);
+  }
 
   /** @return table metadata by oid */
-  TableMetadata *GetTable(table_oid_t table_oid) { return nullptr; }
+  TableMetadata *GetTable(table_oid_t table_oid) {
+    auto it = tables_.find(table_oid);
+    if (it == tables_.end()) {
+      throw std::out_of_range("Table oid " + std::to_string(table_oid) + " does not exist.");
+    }
+    return it->second.get();
+  }
 
   /**
    * Create a new index, populate existing data of the table and return its metadata.
@@ -95,25 +120,87 @@ class Catalog {
    * @param key_schema the schema of the key
    * @param key_attrs key attributes
    * @param keysize size of the key
+   * @param index_type the data structure backing the index; hash indexes only answer equality lookups
    * @return a pointer to the metadata of the new table
    */
   template <class KeyType, class ValueType, class KeyComparator>
   IndexInfo *CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name,
                          const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs,
-                         size_t keysize) {
-    return nullptr;
+                         size_t keysize, IndexType index_type = IndexType::BPlusTreeIndex) {
+    TableMetadata *table_info = GetTable(table_name);
+    // The metadata passes to the index as the index is constructed; either frees it if the construction or the
+    // population below throws.
+    auto metadata = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
+    std::unique_ptr<Index> index;
+    if (index_type == IndexType::HashTableIndex) {
+      HashFunction<KeyType> hash_fn = MakeHashFunction<KeyType>(*metadata->GetKeySchema());
+      index = std::make_unique<LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>>(
+          std::move(metadata), bpm_, DEFAULT_HASH_INDEX_BUCKETS, hash_fn);
+    } else {
+      index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(metadata), bpm_);
+    }
+
+    // Populate the index with the tuples already in the table.
+    for (auto it = table_info->table_->Begin(txn); it != table_info->table_->End(); ++it) {
+      index->InsertEntry(it->KeyFromTuple(schema, *index->GetKeySchema(), key_attrs), it->GetRid(), txn);
+    }
+
+    index_oid_t index_oid = next_index_oid_++;
+    indexes_[index_oid] = std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name,
+                                                      keysize, index_type);
+    index_names_[table_name][index_name] = index_oid;
+    return indexes_[index_oid].get();
   }
 
-  IndexInfo *GetIndex(const std::string &index_name, const std::string &table_name) { return nullptr; }
+  IndexInfo *GetIndex(const std::string &index_name, const std::string &table_name) {
+    auto table_it = index_names_.find(table_name);
+    if (table_it == index_names_.end() || table_it->second.count(index_name) == 0) {
+      throw std::out_of_range("Index " + index_name + " on table " + table_name + " does not exist.");
+    }
+    return GetIndex(table_it->second.at(index_name));
+  }
 
-  IndexInfo *GetIndex(index_oid_t index_oid) { return nullptr; }
+  IndexInfo *GetIndex(index_oid_t index_oid) {
+    auto it = indexes_.find(index_oid);
+    if (it == indexes_.end()) {
+      throw std::out_of_range("Index oid " + std::to_string(index_oid) + " does not exist.");
+    }
+    return it->second.get();
+  }
 
-  std::vector<IndexInfo *> GetTableIndexes(const std::string &table_name) { return std::vector<IndexInfo *>(); }
+  std::vector<IndexInfo *> GetTableIndexes(const std::string &table_name) {
+    std::vector<IndexInfo *> result;
+    auto table_it = index_names_.find(table_name);
+    if (table_it == index_names_.end()) {
+      return result;
+    }
+    for (const auto &[name, oid] : table_it->second) {
+      result.push_back(indexes_[oid].get());
+    }
+    return result;
+  }
 
  private:
-  [[maybe_unused]] BufferPoolManager *bpm_;
-  [[maybe_unused]] LockManager *lock_manager_;
-  [[maybe_unused]] LogManager *log_manager_;
+  /** Initial number of buckets of a hash index; the table doubles itself when it fills up. */
+  static constexpr size_t DEFAULT_HASH_INDEX_BUCKETS = 1024;
+
+  /**
+   * @return a hash function that only covers the serialized key, when the key type supports it. A key with a
+   * VARCHAR column keeps its characters after the fixed-length part, so such a key is hashed whole.
+   */
+  template <class KeyType>
+  static HashFunction<KeyType> MakeHashFunction(const Schema &key_schema) {
+    if constexpr (std::is_constructible_v<HashFunction<KeyType>, uint32_t>) {
+      if (key_schema.IsInlined()) {
+        return HashFunction<KeyType>(key_schema.GetLength());
+      }
+    }
+    return HashFunction<KeyType>();
+  }
+
+  BufferPoolManager *bpm_;
+  LockManager *lock_manager_;
+  LogManager *log_manager_;
 
   /** tables_ : table identifiers -> table metadata. Note that tables_ owns all table metadata. */
   std::unordered_map<table_oid_t, std::unique_ptr<TableMetadata>> tables_;
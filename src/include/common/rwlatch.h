@@ -93,4 +93,32 @@ class ReaderWriterLatch {
   bool writer_entered_{false};
 };
 
+/**
+ * Holds the read latch of a ReaderWriterLatch until it goes out of scope.
+ */
+class ReadLatchGuard {
+ public:
+  explicit ReadLatchGuard(ReaderWriterLatch *latch) : latch_(latch) { latch_->RLock(); }
+  ~ReadLatchGuard() { latch_->RUnlock(); }
+
+  DISALLOW_COPY_AND_MOVE(ReadLatchGuard);
+
+ private:
+  ReaderWriterLatch *latch_;
+};
+
+/**
+ * Holds the write latch of a ReaderWriterLatch until it goes out of scope.
+ */
+class WriteLatchGuard {
+ public:
+  explicit WriteLatchGuard(ReaderWriterLatch *latch) : latch_(latch) { latch_->WLock(); }
+  ~WriteLatchGuard() { latch_->WUnlock(); }
+
+  DISALLOW_COPY_AND_MOVE(WriteLatchGuard);
+
+ private:
+  ReaderWriterLatch *latch_;
+};
+
 }  // namespace bustub
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// thread_pool.h
+//
+// Identification: src/include/common/thread_pool.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * ThreadPool runs submitted tasks on a fixed set of threads, in submission order. Tasks report their own
+ * completion; the pool only guarantees that every submitted task runs before the pool is destroyed.
+ *
+ * Tasks that wait for each other must all be running at the same time, which a queued task behind busy threads is
+ * not. Such tasks reserve idle threads first and are submitted with SubmitReserved.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Starts the threads.
+   * @param num_threads the number of threads, or 0 for one per hardware thread
+   */
+  explicit ThreadPool(size_t num_threads = 0);
+
+  DISALLOW_COPY_AND_MOVE(ThreadPool);
+
+  /** Runs the tasks still queued, then stops the threads. */
+  ~ThreadPool();
+
+  /** Queues a task to run on one of the threads. */
+  void Submit(std::function<void()> task);
+
+  /**
+   * Reserves threads that are neither running a task nor needed by a queued one, so that tasks submitted on them
+   * start right away.
+   * @param num_threads the number of threads wanted
+   * @return the number of threads reserved, at most num_threads and possibly 0; each is used by one SubmitReserved
+   */
+  size_t TryReserve(size_t num_threads);
+
+  /** Queues a task on a thread reserved by TryReserve. The reservation ends when the task does. */
+  void SubmitReserved(std::function<void()> task);
+
+  /** @return the number of threads, which is how many tasks can run at the same time */
+  size_t GetNumThreads() const { return threads_.size(); }
+
+ private:
+  /** The body of each thread: runs tasks until the pool shuts down. */
+  void Work();
+
+  std::mutex latch_;
+  /** Signaled when a task is queued or the pool shuts down. */
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  /** The number of tasks queued or running, plus the reserved threads whose task has not been submitted yet. */
+  size_t num_busy_{0};
+  bool shutdown_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace bustub
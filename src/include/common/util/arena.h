@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.h
+//
+// Identification: src/include/common/util/arena.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * Arena hands out memory by bumping a pointer through large blocks, and frees it all at once in Reset or when the
+ * arena is destroyed; there is no way to free a single allocation. It suits the many small, short-lived allocations of
+ * a query, which would otherwise each be a malloc and a free.
+ *
+ * An arena is not thread safe.
+ */
+class Arena {
+ public:
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  /** @param block_size the size of the blocks the arena allocates from */
+  explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE) : block_size_(block_size) {}
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+
+  ~Arena() = default;
+
+  /**
+   * Allocates memory that stays valid until the arena is reset or destroyed.
+   * @param size the number of bytes
+   * @param alignment the alignment of the memory, a power of two
+   * @return the memory, which is not initialized
+   */
+  char *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    auto aligned = AlignUp(reinterpret_cast<uintptr_t>(cur_), alignment);
+    if (cur_ == nullptr || aligned + size > reinterpret_cast<uintptr_t>(end_)) {
+      return AllocateSlow(size, alignment);
+    }
+    cur_ = reinterpret_cast<char *>(aligned + size);
+    bytes_allocated_ += size;
+    return reinterpret_cast<char *>(aligned);
+  }
+
+  /** Frees everything allocated so far. The first block is kept for the allocations that follow. */
+  void Reset() {
+    large_blocks_.clear();
+    if (blocks_.size() > 1) {
+      blocks_.resize(1);
+    }
+    cur_ = blocks_.empty() ? nullptr : blocks_.front().get();
+    end_ = blocks_.empty() ? nullptr : cur_ + block_size_;
+    memory_usage_ = blocks_.size() * block_size_;
+    bytes_allocated_ = 0;
+  }
+
+  /** @return the number of bytes handed out since the arena was created or reset */
+  size_t GetBytesAllocated() const { return bytes_allocated_; }
+
+  /** @return the number of bytes the arena holds, including the unused ends of its blocks */
+  size_t GetMemoryUsage() const { return memory_usage_; }
+
+ private:
+  static uintptr_t AlignUp(uintptr_t address, size_t alignment) { return (address + alignment - 1) & ~(alignment - 1); }
+
+  char *AllocateSlow(size_t size, size_t alignment) {
+    bytes_allocated_ += size;
+    // Large allocations get a block of their own, so they do not waste the rest of the current block.
+    if (size + alignment > block_size_ / 4) {
+      large_blocks_.emplace_back(new char[size + alignment]);
+      memory_usage_ += size + alignment;
+      return reinterpret_cast<char *>(AlignUp(reinterpret_cast<uintptr_t>(large_blocks_.back().get()), alignment));
+    }
+    blocks_.emplace_back(new char[block_size_]);
+    memory_usage_ += block_size_;
+    cur_ = blocks_.back().get();
+    end_ = cur_ + block_size_;
+    auto aligned = AlignUp(reinterpret_cast<uintptr_t>(cur_), alignment);
+    cur_ = reinterpret_cast<char *>(aligned + size);
+    return reinterpret_cast<char *>(aligned);
+  }
+
+  size_t block_size_;
+  /** The blocks of block_size_ bytes; the last one is allocated from. */
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  /** The blocks of single large allocations. */
+  std::vector<std::unique_ptr<char[]>> large_blocks_;
+  char *cur_{nullptr};
+  char *end_{nullptr};
+  size_t bytes_allocated_{0};
+  size_t memory_usage_{0};
+};
+
+}  // namespace bustub
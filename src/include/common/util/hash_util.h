@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -47,6 +48,37 @@ class HashUtil {
 
   static inline hash_t SumHashes(hash_t l, hash_t r) { return (l % prime_factor + r % prime_factor) % prime_factor; }
 
+  /**
+   * MurmurHash3's 64-bit finalizer. Every input bit affects every output bit, so both the low bits (used to pick a
+   * slot) and the high bits (used for fingerprints) of the result are usable.
+   */
+  static inline uint64_t Mix64(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  /** Hashes bytes a word at a time; cheaper than MurmurHash3_x64_128 for the short keys indexes deal with. */
+  static inline uint64_t HashBytes64(const char *bytes, size_t length) {
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    uint64_t hash = length * multiplier;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes + i, sizeof(uint64_t));
+      hash = (hash ^ Mix64(word)) * multiplier;
+    }
+    if (i < length) {
+      uint64_t word = 0;
+      memcpy(&word, bytes + i, length - i);
+      hash = (hash ^ Mix64(word)) * multiplier;
+    }
+    return Mix64(hash);
+  }
+
   template <typename T>
   static inline hash_t Hash(const T *ptr) {
     return HashBytes(reinterpret_cast<const char *>(ptr), sizeof(T));
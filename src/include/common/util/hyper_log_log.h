@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hyper_log_log.h
+//
+// Identification: src/include/common/util/hyper_log_log.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * HyperLogLog estimates the number of distinct values it has seen in a fixed NUM_REGISTERS bytes, and serializes into
+ * at most MAX_SERIALIZED_SIZE, so that a sketch fits in a page. Values are added by their 64-bit hash, which must mix
+ * its bits well (e.g. HashUtil::Mix64 or HashBytes64). Two sketches merge into the sketch of the union of their
+ * values, so partial sketches can be built in parallel or spilled and combined later.
+ *
+ * With 2^12 registers the standard error of the estimate is about 1.6%.
+ */
+class HyperLogLog {
+ public:
+  /** The number of hash bits that pick a register. */
+  static constexpr uint32_t PRECISION = 12;
+  static constexpr uint32_t NUM_REGISTERS = 1U << PRECISION;
+
+  HyperLogLog() : registers_(NUM_REGISTERS, 0) {}
+
+  /** Adds a value by its hash. */
+  void Add(uint64_t hash) {
+    uint32_t idx = hash >> (64 - PRECISION);
+    // The rank of the remaining bits is the position of their first one bit; the sentinel bit caps it.
+    uint64_t rest = (hash << PRECISION) | (uint64_t{1} << (PRECISION - 1));
+    auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[idx] = std::max(registers_[idx], rank);
+  }
+
+  /** Forgets every value added, keeping the registers' memory. */
+  void Clear() { std::fill(registers_.begin(), registers_.end(), 0); }
+
+  /** Adds the values of another sketch to this one. */
+  void Merge(const HyperLogLog &other) {
+    for (uint32_t i = 0; i < NUM_REGISTERS; i++) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  /** @return the estimated number of distinct values added */
+  uint64_t Estimate() const {
+    const double m = NUM_REGISTERS;
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint8_t rank : registers_) {
+      sum += std::ldexp(1.0, -rank);
+      zeros += rank == 0 ? 1 : 0;
+    }
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+      // Few values: linear counting over the empty registers is more accurate.
+      estimate = m * std::log(m / zeros);
+    }
+    return static_cast<uint64_t>(std::llround(estimate));
+  }
+
+  /** @return the number of bytes SerializeTo writes */
+  uint32_t GetSerializedSize() const { return SizeOf(NumSet()); }
+
+  /**
+   * Writes the sketch to storage, as the number of registers set followed by either the index and rank of each of
+   * them, while that is smaller, or every register packed into RANK_BITS bits.
+   */
+  void SerializeTo(char *storage) const {
+    uint16_t num_set = NumSet();
+    memcpy(storage, &num_set, sizeof(uint16_t));
+    storage += sizeof(uint16_t);
+    if (SizeOf(num_set) < MAX_SERIALIZED_SIZE) {
+      for (uint16_t i = 0; i < NUM_REGISTERS; i++) {
+        if (registers_[i] != 0) {
+          memcpy(storage, &i, sizeof(uint16_t));
+          storage[sizeof(uint16_t)] = static_cast<char>(registers_[i]);
+          storage += SPARSE_ENTRY_SIZE;
+        }
+      }
+      return;
+    }
+    memset(storage, 0, MAX_SERIALIZED_SIZE - sizeof(uint16_t));
+    for (uint32_t i = 0; i < NUM_REGISTERS; i++) {
+      uint32_t bit = i * RANK_BITS;
+      uint16_t bits = registers_[i] << (bit % 8);
+      storage[bit / 8] = static_cast<char>(storage[bit / 8] | (bits & 0xFF));
+      if (bits > 0xFF) {
+        storage[bit / 8 + 1] = static_cast<char>(storage[bit / 8 + 1] | (bits >> 8));
+      }
+    }
+  }
+
+  /** Reads a sketch written by SerializeTo. */
+  void DeserializeFrom(const char *storage) {
+    uint16_t num_set;
+    memcpy(&num_set, storage, sizeof(uint16_t));
+    storage += sizeof(uint16_t);
+    std::fill(registers_.begin(), registers_.end(), 0);
+    if (SizeOf(num_set) < MAX_SERIALIZED_SIZE) {
+      for (uint16_t j = 0; j < num_set; j++, storage += SPARSE_ENTRY_SIZE) {
+        uint16_t i;
+        memcpy(&i, storage, sizeof(uint16_t));
+        registers_[i] = static_cast<uint8_t>(storage[sizeof(uint16_t)]);
+      }
+      return;
+    }
+    const auto *bytes = reinterpret_cast<const uint8_t *>(storage);
+    for (uint32_t i = 0; i < NUM_REGISTERS; i++) {
+      uint32_t bit = i * RANK_BITS;
+      uint32_t bits = bytes[bit / 8] >> (bit % 8);
+      if (bit % 8 + RANK_BITS > 8) {
+        bits |= static_cast<uint32_t>(bytes[bit / 8 + 1]) << (8 - bit % 8);
+      }
+      registers_[i] = static_cast<uint8_t>(bits & ((1U << RANK_BITS) - 1));
+    }
+  }
+
+  /** @return the size of a sketch serialized by SerializeTo at storage */
+  static uint32_t SerializedSize(const char *storage) {
+    uint16_t num_set;
+    memcpy(&num_set, storage, sizeof(uint16_t));
+    return SizeOf(num_set);
+  }
+
+  /** A rank is at most 64 - PRECISION + 1, so it fits in RANK_BITS bits. */
+  static constexpr uint32_t RANK_BITS = 6;
+  /** The most bytes a serialized sketch takes. */
+  static constexpr uint32_t MAX_SERIALIZED_SIZE = sizeof(uint16_t) + NUM_REGISTERS * RANK_BITS / 8;
+
+ private:
+  /** A register set in a sparse sketch is its 16-bit index and its rank. */
+  static constexpr uint32_t SPARSE_ENTRY_SIZE = sizeof(uint16_t) + 1;
+
+  static uint32_t SizeOf(uint16_t num_set) {
+    return std::min<uint32_t>(sizeof(uint16_t) + num_set * SPARSE_ENTRY_SIZE, MAX_SERIALIZED_SIZE);
+  }
+
+  uint16_t NumSet() const {
+    return static_cast<uint16_t>(NUM_REGISTERS - std::count(registers_.begin(), registers_.end(), 0));
+  }
+
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table.h
+//
+// Identification: src/include/container/hash/extendible_hash_table.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/transaction.h"
+#include "container/hash/hash_function.h"
+#include "container/hash/hash_table.h"
+#include "storage/index/generic_key.h"
+#include "storage/page/hash_table_bucket_page.h"
+#include "storage/page/hash_table_directory_page.h"
+#include "storage/page/hash_table_page_defs.h"
+#include "storage/page/page_guard.h"
+
+namespace bustub {
+
+#define EXTENDIBLE_HASH_TABLE_TYPE ExtendibleHashTable<KeyType, ValueType, KeyComparator>
+
+/**
+ * Implementation of extendible hashing that is backed by a buffer pool
+ * manager. Non-unique keys are supported. Supports insert and delete. The
+ * table grows one bucket at a time: a full bucket is split in two, and the
+ * directory only doubles when the bucket's local depth equals the global
+ * depth. Empty buckets are merged back into their split image.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class ExtendibleHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
+ public:
+  /**
+   * Creates a new ExtendibleHashTable.
+   *
+   * @param name the name of the hash table
+   * @param buffer_pool_manager buffer pool manager to be used
+   * @param comparator comparator for keys
+   * @param hash_fn the hash function
+   * @throws Exception OUT_OF_MEMORY if the buffer pool has no room for the directory or the first bucket
+   */
+  explicit ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                               const KeyComparator &comparator, HashFunction<KeyType> hash_fn);
+
+  /**
+   * Inserts a key-value pair into the hash table.
+   *
+   * @param transaction the current transaction
+   * @param key the key to create
+   * @param value the value to be associated with the key
+   * @return true if insert succeeded, false if the pair already exists
+   * @throws Exception OUT_OF_RANGE if the key's bucket is full and cannot be split, either because the directory is at
+   * its maximum size or because every key in the bucket has the same hash as the new one
+   */
+  bool Insert(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Deletes the associated value for the given key.
+   *
+   * @param transaction the current transaction
+   * @param key the key to delete
+   * @param value the value to delete
+   * @return true if remove succeeded, false otherwise
+   */
+  bool Remove(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Performs a point query on the hash table.
+   *
+   * @param transaction the current transaction
+   * @param key the key to look up
+   * @param[out] result the value(s) associated with a given key
+   * @return the value(s) associated with the given key
+   */
+  bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) override;
+
+  /**
+   * Returns the global depth of the directory.
+   *
+   * @return the global depth
+   */
+  uint32_t GetGlobalDepth();
+
+  /**
+   * Helper function to verify the integrity of the extendible hash table's directory.
+   */
+  void VerifyIntegrity();
+
+ private:
+  /**
+   * Hash - simple helper to downcast MurmurHash's 64-bit hash to 32-bit
+   * for extendible hashing.
+   *
+   * @param key the key to hash
+   * @return the downcasted 32-bit hash
+   */
+  inline uint32_t Hash(KeyType key);
+
+  /**
+   * KeyToDirectoryIndex - maps a key to a directory index
+   *
+   * @param key the key to hash
+   * @param dir_page a pointer to the hash table's directory page
+   * @return the directory index
+   */
+  inline uint32_t KeyToDirectoryIndex(KeyType key, const HashTableDirectoryPage *dir_page);
+
+  /**
+   * Fetches and read latches the directory page.
+   *
+   * @return a guard over the directory page
+   */
+  ReadPageGuard FetchDirectoryPageRead();
+
+  /**
+   * Fetches and write latches the directory page.
+   *
+   * @return a guard over the directory page
+   */
+  WritePageGuard FetchDirectoryPageWrite();
+
+  /**
+   * Fetches and read latches a bucket page using the bucket's page_id.
+   *
+   * @param bucket_page_id the page_id to fetch
+   * @return a guard over the bucket page
+   */
+  ReadPageGuard FetchBucketPageRead(page_id_t bucket_page_id);
+
+  /**
+   * Fetches and write latches a bucket page using the bucket's page_id.
+   *
+   * @param bucket_page_id the page_id to fetch
+   * @return a guard over the bucket page
+   */
+  WritePageGuard FetchBucketPageWrite(page_id_t bucket_page_id);
+
+  /**
+   * Performs insertion with an optional bucket splitting. Splits one bucket at
+   * a time until the key fits, doubling the directory only when necessary.
+   *
+   * @param transaction a pointer to the current transaction
+   * @param key the key to insert
+   * @param value the value to insert
+   * @return true if inserted, false if the pair already exists
+   * @throws Exception OUT_OF_RANGE if the bucket cannot be split, see Insert
+   */
+  bool SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value);
+
+  /**
+   * Optionally merges an empty bucket into its split image, shrinking the
+   * directory if possible.
+   *
+   * @param transaction a pointer to the current transaction
+   * @param key the key that was removed
+   * @param value the value that was removed
+   */
+  void Merge(Transaction *transaction, const KeyType &key, const ValueType &value);
+
+  // member variables
+  page_id_t directory_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+
+  // Readers includes inserts and removes that fit in their bucket, writer is only split and merge
+  ReaderWriterLatch table_latch_;
+
+  // Hash function
+  HashFunction<KeyType> hash_fn_;
+};
+
+}  // namespace bustub
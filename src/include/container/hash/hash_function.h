@@ -12,13 +12,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <type_traits>
 
+#include "common/util/hash_util.h"
 #include "murmur3/MurmurHash3.h"
 
 namespace bustub {
 
-template <typename KeyType>
+template <size_t KeySize>
+class GenericKey;
+
+template <typename KeyType, typename Enable = void>
 class HashFunction {
  public:
   /**
@@ -33,4 +39,44 @@ class HashFunction {
   }
 };
 
+/**
+ * Integral keys fit in a register, so a single 64-bit finalizer replaces the
+ * full MurmurHash3_x64_128 pass.
+ */
+template <typename KeyType>
+class HashFunction<KeyType, std::enable_if_t<std::is_integral_v<KeyType>>> {
+ public:
+  /**
+   * @param key the key to be hashed
+   * @return the hashed value
+   */
+  virtual uint64_t GetHash(KeyType key) { return HashUtil::Mix64(static_cast<uint64_t>(key)); }
+};
+
+/**
+ * GenericKey<KeySize> is zero padded up to KeySize bytes, but only the first
+ * key_length bytes (the serialized key tuple) carry data. Hashing just those
+ * bytes makes e.g. an 8 byte key in GenericKey<64> as cheap as in GenericKey<8>.
+ */
+template <size_t KeySize>
+class HashFunction<GenericKey<KeySize>> {
+ public:
+  /**
+   * @param key_length the length of the serialized key, usually the key schema's GetLength(); defaults to the whole
+   * key. Only pass a shorter length when every key column is inlined: GetLength() covers just the fixed-length part
+   * of the tuple, which for a VARCHAR column is its offset and length, not its characters, so all such keys would
+   * hash alike.
+   */
+  explicit HashFunction(uint32_t key_length = KeySize) : key_length_(std::min<uint32_t>(key_length, KeySize)) {}
+
+  /**
+   * @param key the key to be hashed
+   * @return the hashed value
+   */
+  virtual uint64_t GetHash(GenericKey<KeySize> key) { return HashUtil::HashBytes64(key.data_, key_length_); }
+
+ private:
+  uint32_t key_length_;
+};
+
 }  // namespace bustub
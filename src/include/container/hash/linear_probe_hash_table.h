@@ -23,6 +23,7 @@
 #include "storage/page/hash_table_block_page.h"
 #include "storage/page/hash_table_header_page.h"
 #include "storage/page/hash_table_page_defs.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
@@ -32,6 +33,17 @@ namespace bustub {
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * Probing walks groups of BLOCK_GROUP_SIZE slots, comparing the key's hash
+ * fingerprint against a whole group of control bytes at once, and ends at the
+ * first group that has a never-occupied slot.
+ *
+ * Concurrency: the table latch is only taken exclusively by Resize. Every other
+ * operation holds it shared and latches one block page at a time while probing,
+ * so operations on different blocks run in parallel. Inserts only ever claim
+ * never-occupied slots (tombstones are dropped on Resize), which keeps the
+ * duplicate check correct across blocks: a probe sequence only grows at its end,
+ * and the end is checked and claimed under that block's write latch.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
@@ -74,6 +86,17 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
    */
   bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) override;
 
+  /**
+   * Performs a point query for each key of a batch. The header page is fetched
+   * once for the whole batch and probes are ordered by slot, so keys that land
+   * in the same block share one fetch and latch of that block.
+   * @param transaction the current transaction
+   * @param keys the keys to look up
+   * @param[out] results results[i] receives the value(s) associated with keys[i]
+   */
+  void GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                 std::vector<std::vector<ValueType>> *results);
+
   /**
    * Resizes the table to at least twice the initial size provided.
    * @param initial_size the initial size of the hash table
@@ -87,6 +110,52 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
   size_t GetSize();
 
  private:
+  /**
+   * Allocates a header page and enough block pages for num_buckets slots.
+   *
+   * @param num_buckets the minimum number of slots
+   * @return the page id of the new header page
+   */
+  page_id_t CreateTable(size_t num_buckets);
+
+  /**
+   * Probes the table described by header and inserts the pair into the first
+   * never-occupied slot of the last group probed, latching one block page at a time.
+   *
+   * @param header the header page of the table to insert into
+   * @param key the key to insert
+   * @param value the value to insert
+   * @param[out] table_full set to true if every slot was probed without finding a free one
+   * @return true if inserted, false if the pair already exists or the table is full
+   */
+  bool InsertIntoTable(const HashTableHeaderPage *header, const KeyType &key, const ValueType &value,
+                       bool *table_full);
+
+  /**
+   * Fetches and read latches the header page.
+   *
+   * @param header_page_id the header page to fetch
+   * @return a guard over the header page
+   */
+  ReadPageGuard FetchHeaderPage(page_id_t header_page_id);
+
+  /**
+   * Fetches and read latches a block page.
+   *
+   * @param block_page_id the page_id to fetch
+   * @return a guard over the block page
+   */
+  ReadPageGuard FetchBlockPageRead(page_id_t block_page_id);
+
+  /**
+   * Fetches and write latches a block page.
+   *
+   * @param block_page_id the page_id to fetch
+   * @return a guard over the block page
+   */
+  WritePageGuard FetchBlockPageWrite(page_id_t block_page_id);
+
+
   // member variable
   page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.h
+//
+// Identification: src/include/execution/aggregation_hash_table.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "common/util/hyper_log_log.h"
+#include "execution/plans/aggregation_plan.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * AggregationHashTable maps group keys to running aggregates. It is a flat open-addressing table: a group key is
+ * serialized into bytes once, the bytes of all the groups are stored back to back, and a slot is just a hash tag and
+ * a group number, so looking up a group hashes and compares bytes rather than vectors of Values.
+ *
+ * Groups are numbered in insertion order. Two tables over the same group bys and aggregates can be merged, which
+ * combines the partial aggregates of the groups they share. A group can also be spilled as tuples holding its hash,
+ * key and partial aggregates, and merged back from them later.
+ *
+ * Most aggregates are a single running Value. AVG also counts its inputs, COUNT DISTINCT keeps the serialized
+ * distinct values of each group in a hash set, and APPROX COUNT DISTINCT keeps a HyperLogLog sketch per group; all
+ * three ignore NULL inputs, and all of them merge exactly.
+ */
+class AggregationHashTable {
+ public:
+  /**
+   * Creates an empty table.
+   * @param key_types the types of the group by values, used to deserialize the group keys
+   * @param agg_types the types of the aggregates
+   */
+  AggregationHashTable(std::vector<TypeId> key_types, std::vector<AggregationType> agg_types)
+      : key_types_(std::move(key_types)),
+        agg_types_(std::move(agg_types)),
+        avg_counts_(agg_types_.size()),
+        distinct_values_(agg_types_.size()),
+        sketches_(agg_types_.size()) {}
+
+  /**
+   * Appends a group by value to a serialized group key. Group keys that serialize to the same bytes are the same
+   * group; in particular all the NULLs of a column fall into one group.
+   * @param value the next group by value
+   * @param[out] key the serialized key
+   */
+  static void AppendKey(const Value &value, std::vector<char> *key);
+
+  /** @return the hash of a serialized group key */
+  static hash_t HashKey(const std::vector<char> &key) { return HashUtil::HashBytes64(key.data(), key.size()); }
+
+  /**
+   * Combines the aggregate input of one tuple into its group, creating the group if needed.
+   * @param key the serialized group key
+   * @param hash the hash of the key, from HashKey
+   * @param input the values of the aggregate expressions on the tuple
+   */
+  void InsertCombine(const std::vector<char> &key, hash_t hash, const std::vector<Value> &input);
+
+  /**
+   * Combines the aggregate input of one tuple into an existing group, without looking the group up.
+   * @param group the group to combine into
+   * @param input the values of the aggregate expressions on the tuple
+   */
+  void Combine(size_t group, const std::vector<Value> &input);
+
+  /**
+   * Makes the table hold just one group, group 0, with the given key and initial aggregates. Unlike Clear, the memory
+   * of the previous group, including its distinct value set and sketches, is kept for the new one, so a caller that
+   * aggregates one group at a time can reset the table for every group cheaply.
+   * @param key the serialized group key
+   * @param hash the hash of the key, from HashKey
+   */
+  void ResetToGroup(const std::vector<char> &key, hash_t hash);
+
+  /** Combines the partial aggregates of a group of another table into this one. */
+  void MergeGroup(const AggregationHashTable &other, size_t group);
+
+  /** Combines the partial aggregates of every group of another table into this one. */
+  void Merge(const AggregationHashTable &other) {
+    for (size_t group = 0; group < other.GetNumGroups(); group++) {
+      MergeGroup(other, group);
+    }
+  }
+
+  /**
+   * @return a group and its partial aggregates as records for MergeSpilled to read back: one per distinct value of
+   * each COUNT DISTINCT, one per APPROX COUNT DISTINCT sketch, and last the one for the group itself
+   */
+  std::vector<Tuple> SpillGroup(size_t group) const;
+
+  /**
+   * Combines a record of a group spilled by a table like this one into this one. The records merge in any order.
+   * @return true if it was the group's last record, so that spilling this table now would not split the group
+   */
+  bool MergeSpilled(const Tuple &spilled);
+
+  /** @return the hash of the key of the group a spilled record belongs to */
+  static hash_t SpilledHash(const Tuple &spilled) {
+    hash_t hash;
+    memcpy(&hash, spilled.GetData(), sizeof(hash_t));
+    return hash;
+  }
+
+  /** @return the number of groups */
+  size_t GetNumGroups() const { return hashes_.size(); }
+
+  /** @return the hash of the key of a group */
+  hash_t GetHash(size_t group) const { return hashes_[group]; }
+
+  /** @return the number of bytes the table holds */
+  size_t GetMemoryUsage() const {
+    return slots_.size() * sizeof(Slot) + key_data_.size() + key_offsets_.size() * sizeof(size_t) +
+           hashes_.size() * sizeof(hash_t) + aggregates_.size() * sizeof(Value) + side_bytes_;
+  }
+
+  /** @return the group by values of a group */
+  std::vector<Value> GetGroupBys(size_t group) const;
+
+  /** @return the final aggregates of a group */
+  std::vector<Value> GetAggregates(size_t group) const;
+
+  /** Removes all the groups. */
+  void Clear();
+
+ private:
+  /** A slot holds the upper bits of a group's hash, to skip most key comparisons, and the group number plus one. */
+  struct Slot {
+    uint32_t tag_;
+    uint32_t group_;
+  };
+
+  static constexpr size_t INITIAL_SLOTS = 64;
+  /** Marks the spilled record of a group's running aggregates, rather than of one of its aggregates' side state. */
+  static constexpr uint32_t SPILLED_GROUP = UINT32_MAX;
+  /** The bytes a distinct value takes in a hash set, on top of the value itself. */
+  static constexpr size_t DISTINCT_VALUE_OVERHEAD = 64;
+
+  static uint32_t TagOf(hash_t hash) { return static_cast<uint32_t>(hash >> 32); }
+
+  /** @return the running Value an aggregate of the given type starts from */
+  static Value InitialAggregate(AggregationType type);
+
+  /** @return the size of a value of the given type serialized by AppendKey at data */
+  static uint32_t SerializedSize(const char *data, TypeId type);
+
+  /** Combines the partial running Value of aggregate i into the aggregates of a group. */
+  void CombinePartial(size_t group, size_t i, const Value &partial);
+
+  /** Adds a serialized value to the distinct values aggregate i has seen in a group. */
+  void AddDistinct(size_t group, size_t i, std::string &&value);
+
+  /** @return the group with the given serialized key, created with initial aggregates if it does not exist */
+  size_t FindOrInsert(const char *key, uint32_t key_size, hash_t hash);
+
+  /** Doubles the number of slots, re-placing the groups by their saved hashes. */
+  void Grow();
+
+  std::vector<TypeId> key_types_;
+  std::vector<AggregationType> agg_types_;
+  /** The slots; the size is zero or a power of two, and at most half of them are in use. */
+  std::vector<Slot> slots_;
+  /** The serialized group keys, back to back; group i's key is key_data_[key_offsets_[i], key_offsets_[i + 1]). */
+  std::vector<char> key_data_;
+  std::vector<size_t> key_offsets_{0};
+  /** The hash of each group's key. */
+  std::vector<hash_t> hashes_;
+  /** The running aggregates of each group, agg_types_.size() per group. */
+  std::vector<Value> aggregates_;
+  /**
+   * The state of the aggregates that does not fit in their running Value, by aggregate and then by group: the number
+   * of inputs of an AVG, the distinct values of a COUNT DISTINCT and the sketch of an APPROX COUNT DISTINCT. Only
+   * the entries of the aggregates of the matching type are used.
+   */
+  std::vector<std::vector<int64_t>> avg_counts_;
+  std::vector<std::vector<std::unordered_set<std::string>>> distinct_values_;
+  std::vector<std::vector<HyperLogLog>> sketches_;
+  /** The bytes held by distinct_values_ and sketches_. */
+  size_t side_bytes_{0};
+  /** Scratch space for serializing an input value. */
+  std::vector<char> scratch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// cardinality_estimator.h
+//
+// Identification: src/include/execution/cardinality_estimator.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "catalog/catalog.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+/**
+ * CardinalityEstimator guesses how many tuples a plan outputs, from the number of tuples in the tables it scans.
+ * There are no column statistics, so predicates get a fixed selectivity; the estimates are only good for comparing
+ * plans over tables of very different sizes, e.g. to pick the build side of a hash join.
+ */
+class CardinalityEstimator {
+ public:
+  /** A predicate is assumed to let one in this many tuples through, the classic default for an unknown predicate. */
+  static constexpr size_t PREDICATE_SELECTIVITY_INVERSE = 3;
+
+  /**
+   * @param plan the plan to estimate
+   * @param catalog the catalog the plan's tables are registered in
+   * @return the estimated number of tuples the plan outputs
+   */
+  static size_t Estimate(const AbstractPlanNode *plan, Catalog *catalog);
+
+ private:
+  /** @return the estimated number of tuples of a table scan with an optional predicate */
+  static size_t EstimateScan(TableMetadata *table_info, const AbstractExpression *predicate);
+};
+}  // namespace bustub
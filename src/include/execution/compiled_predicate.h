@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_predicate.h
+//
+// Identification: src/include/execution/compiled_predicate.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "storage/table/tuple.h"
+#include "type/limits.h"
+
+namespace bustub {
+/**
+ * CompiledPredicate evaluates a predicate over tuples of one schema without going through Values. When it is
+ * created, a comparison between a fixed-width numeric column and a constant, or between two columns of the same
+ * fixed-width numeric type, is resolved into a kernel instantiated for the column types and the comparison, which
+ * reads the column straight out of the tuple's bytes. Every other predicate is interpreted as usual.
+ *
+ * In both cases a comparison involving NULL does not satisfy the predicate.
+ */
+class CompiledPredicate {
+ public:
+  /** A comparison between a column and a non-NULL constant, with the column on the left. */
+  struct ColumnComparison {
+    /** The type and offset in the tuple of the column. */
+    TypeId column_type_;
+    uint32_t column_offset_;
+    ComparisonType comp_type_;
+    /** True if the comparison is done on doubles, false if it is done on 64-bit integers. */
+    bool as_decimal_;
+    /** The constant, in the domain the comparison is done in. */
+    int64_t integer_constant_;
+    double decimal_constant_;
+  };
+
+  /**
+   * Compiles a predicate.
+   * @param predicate the predicate, or nullptr to accept every tuple
+   * @param schema the schema of the tuples the predicate will be evaluated on; must outlive this object
+   */
+  CompiledPredicate(const AbstractExpression *predicate, const Schema *schema);
+
+  /** @return true if the tuple satisfies the predicate */
+  bool Evaluate(const Tuple *tuple) const { return kernel_(this, tuple); }
+
+  /** @return true if the predicate was compiled into a kernel rather than left to be interpreted */
+  bool IsCompiled() const { return compiled_; }
+
+  /**
+   * Lets callers that hold a whole column, rather than single tuples, apply the predicate themselves.
+   * @return the predicate as a column-constant comparison, or nullptr if it has another shape
+   */
+  const ColumnComparison *GetColumnComparison() const {
+    return has_column_comparison_ ? &column_comparison_ : nullptr;
+  }
+
+ private:
+  using Kernel = bool (*)(const CompiledPredicate *, const Tuple *);
+
+  /** @return true if the raw column value is its type's NULL */
+  template <typename T>
+  static bool IsNullValue(T value) {
+    if constexpr (std::is_same_v<T, int8_t>) {
+      return value == BUSTUB_INT8_NULL;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+      return value == BUSTUB_INT16_NULL;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return value == BUSTUB_INT32_NULL;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return value == BUSTUB_INT64_NULL;
+    } else {
+      return value <= BUSTUB_DECIMAL_NULL;
+    }
+  }
+
+  template <typename T>
+  static T ReadColumn(const Tuple *tuple, uint32_t offset) {
+    T value;
+    memcpy(&value, tuple->GetData() + offset, sizeof(T));
+    return value;
+  }
+
+  /** Compares a column stored as T with the constant, both widened to C. */
+  template <typename T, typename C, typename Op>
+  static bool ColumnConstant(const CompiledPredicate *self, const Tuple *tuple) {
+    T lhs = ReadColumn<T>(tuple, self->column_comparison_.column_offset_);
+    if (IsNullValue(lhs)) {
+      return false;
+    }
+    if constexpr (std::is_same_v<C, double>) {
+      return Op()(static_cast<double>(lhs), self->column_comparison_.decimal_constant_);
+    } else {
+      return Op()(static_cast<int64_t>(lhs), self->column_comparison_.integer_constant_);
+    }
+  }
+
+  /** Compares two columns both stored as T. */
+  template <typename T, typename Op>
+  static bool ColumnColumn(const CompiledPredicate *self, const Tuple *tuple) {
+    T lhs = ReadColumn<T>(tuple, self->lhs_offset_);
+    T rhs = ReadColumn<T>(tuple, self->rhs_offset_);
+    if (IsNullValue(lhs) || IsNullValue(rhs)) {
+      return false;
+    }
+    return Op()(lhs, rhs);
+  }
+
+  static bool AlwaysTrue(const CompiledPredicate *self, const Tuple *tuple) { return true; }
+
+  static bool AlwaysFalse(const CompiledPredicate *self, const Tuple *tuple) { return false; }
+
+  static bool Interpret(const CompiledPredicate *self, const Tuple *tuple);
+
+  /** Picks the kernel for a comparison between a column of the given type and a constant. */
+  template <typename Op>
+  static Kernel ColumnConstantKernel(TypeId column_type, bool as_decimal);
+
+  /** Picks the kernel for a comparison between two columns of the given type. */
+  template <typename Op>
+  static Kernel ColumnColumnKernel(TypeId column_type);
+
+  /**
+   * Tries to compile the predicate into a kernel.
+   * @return false if the predicate does not have a compiled form
+   */
+  bool Compile();
+
+  const AbstractExpression *predicate_;
+  const Schema *schema_;
+  Kernel kernel_{&Interpret};
+  bool compiled_{false};
+
+  /** The offsets in the tuple of the columns of a column-column comparison. */
+  uint32_t lhs_offset_{0};
+  uint32_t rhs_offset_{0};
+  /** The comparison, when the predicate compares a column with a constant. */
+  ColumnComparison column_comparison_{};
+  bool has_column_comparison_{false};
+};
+
+}  // namespace bustub
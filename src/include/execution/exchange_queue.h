@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// exchange_queue.h
+//
+// Identification: src/include/execution/exchange_queue.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <mutex>  // NOLINT
+
+#include "common/macros.h"
+#include "execution/tuple_batch.h"
+
+namespace bustub {
+
+/**
+ * ExchangeQueue carries batches of tuples from the worker threads producing them to the one executor consuming
+ * them. It is bounded, so producers that run ahead of the consumer block instead of buffering the whole result.
+ *
+ * Either side can end the exchange early: the consumer by closing the queue, which makes every later Push fail so
+ * producers stop, and a producer by failing it, which makes Pop rethrow the producer's exception.
+ */
+class ExchangeQueue {
+ public:
+  /** Enough batches to keep every worker of a large machine busy while the consumer catches up. */
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+  /**
+   * Creates an empty queue.
+   * @param num_producers the number of producers that will call ProducerDone
+   * @param capacity the maximum number of batches held
+   */
+  explicit ExchangeQueue(uint32_t num_producers, size_t capacity = DEFAULT_CAPACITY)
+      : num_producers_(num_producers), capacity_(capacity) {}
+
+  DISALLOW_COPY_AND_MOVE(ExchangeQueue);
+
+  /**
+   * Adds a batch, blocking while the queue is full.
+   * @return false if the queue was closed, in which case the producer should stop
+   */
+  bool Push(TupleBatch &&batch);
+
+  /** Signals that one producer will not push any more batches. */
+  void ProducerDone();
+
+  /** Records the exception a producer stopped on, to be rethrown to the consumer. */
+  void Fail(std::exception_ptr error);
+
+  /**
+   * Removes a batch, blocking while the queue is empty and some producer is still running.
+   * @param[out] batch the batch removed
+   * @return false once every producer is done and every batch has been removed
+   */
+  bool Pop(TupleBatch *batch);
+
+  /** Stops the exchange: pending batches are dropped and producers are told to stop. */
+  void Close();
+
+  /** Blocks until every producer is done, after which nothing refers to the producers' state any more. */
+  void WaitForProducers();
+
+ private:
+  std::mutex latch_;
+  /** Signaled when a batch is added, the last producer finishes or a producer fails. */
+  std::condition_variable not_empty_;
+  /** Signaled when a batch is removed or the queue is closed. */
+  std::condition_variable not_full_;
+  std::deque<TupleBatch> batches_;
+  uint32_t num_producers_;
+  size_t capacity_;
+  bool closed_{false};
+  std::exception_ptr error_;
+};
+
+}  // namespace bustub
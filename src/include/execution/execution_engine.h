@@ -12,25 +12,37 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/catalog.h"
+#include "common/thread_pool.h"
 #include "concurrency/transaction_manager.h"
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 namespace bustub {
 class ExecutionEngine {
  public:
-  ExecutionEngine(BufferPoolManager *bpm, TransactionManager *txn_mgr, Catalog *catalog)
-      : bpm_(bpm), txn_mgr_(txn_mgr), catalog_(catalog) {}
+  /**
+   * Creates an execution engine.
+   * @param bpm the buffer pool manager
+   * @param txn_mgr the transaction manager
+   * @param catalog the catalog
+   * @param num_threads the number of threads parallel plans run on, or 0 for one per hardware thread
+   */
+  ExecutionEngine(BufferPoolManager *bpm, TransactionManager *txn_mgr, Catalog *catalog, size_t num_threads = 0)
+      : bpm_(bpm), txn_mgr_(txn_mgr), catalog_(catalog), thread_pool_(std::make_unique<ThreadPool>(num_threads)) {}
 
   DISALLOW_COPY_AND_MOVE(ExecutionEngine);
 
   bool Execute(const AbstractPlanNode *plan, std::vector<Tuple> *result_set, Transaction *txn,
                ExecutorContext *exec_ctx) {
+    exec_ctx->SetThreadPool(thread_pool_.get());
+
     // construct executor
     auto executor = ExecutorFactory::CreateExecutor(exec_ctx, plan);
 
@@ -39,11 +51,13 @@ class ExecutionEngine {
 
     // execute
     try {
-      Tuple tuple;
-      RID rid;
-      while (executor->Next(&tuple, &rid)) {
+      TupleBatch batch;
+      while (executor->NextBatch(&batch)) {
         if (result_set != nullptr) {
-          result_set->push_back(tuple);
+          for (size_t i = 0; i < batch.Size(); i++) {
+            // The tuples may live in the batch's arena, which the next NextBatch frees.
+            result_set->push_back(batch.GetTuple(i).Materialize());
+          }
         }
       }
     } catch (Exception &e) {
@@ -57,6 +71,8 @@ class ExecutionEngine {
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] TransactionManager *txn_mgr_;
   [[maybe_unused]] Catalog *catalog_;
+  /** The threads the workers of parallel plans run on. */
+  std::unique_ptr<ThreadPool> thread_pool_;
 };
 
 }  // namespace bustub
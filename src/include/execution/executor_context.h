@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <limits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/thread_pool.h"
 #include "concurrency/transaction.h"
+#include "execution/parallel_context.h"
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
@@ -60,12 +63,45 @@ class ExecutorContext {
   /** @return the transaction manager */
   TransactionManager *GetTransactionManager() { return txn_mgr_; }
 
+  /** @return the bytes of tuples each memory-hungry executor may hold before it spills to temporary pages */
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** Sets the bytes of tuples each memory-hungry executor may hold before it spills to temporary pages. */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /** @return the threads parallel executors run their workers on, or nullptr outside of an ExecutionEngine */
+  ThreadPool *GetThreadPool() { return thread_pool_; }
+
+  /** Sets the threads parallel executors run their workers on. */
+  void SetThreadPool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
+  /** @return the state shared with the other workers of a parallel plan, or nullptr if not running as a worker */
+  ParallelContext *GetParallelContext() { return parallel_ctx_; }
+
+  /** @return the id of this worker among the workers of a parallel plan */
+  uint32_t GetWorkerId() const { return worker_id_; }
+
+  /**
+   * Makes the executors run as one of the workers of a parallel plan.
+   * @param parallel_ctx the state shared by the workers
+   * @param worker_id the id of this worker, in [0, parallel_ctx->GetNumWorkers())
+   */
+  void SetWorker(ParallelContext *parallel_ctx, uint32_t worker_id) {
+    parallel_ctx_ = parallel_ctx;
+    worker_id_ = worker_id;
+  }
+
  private:
   Transaction *transaction_;
   Catalog *catalog_;
   BufferPoolManager *bpm_;
   TransactionManager *txn_mgr_;
   LockManager *lock_mgr_;
+  /** Unlimited by default, so nothing spills. */
+  size_t memory_budget_{std::numeric_limits<size_t>::max()};
+  ThreadPool *thread_pool_{nullptr};
+  ParallelContext *parallel_ctx_{nullptr};
+  uint32_t worker_id_{0};
 };
 
 }  // namespace bustub
@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include "common/config.h"
+#include "common/util/arena.h"
 #include "execution/executor_context.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 /**
- * AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
+ * AbstractExecutor implements the Volcano tuple-at-a-time iterator model, with an optional batch-at-a-time
+ * interface on top of it.
  */
 class AbstractExecutor {
  public:
@@ -37,13 +41,32 @@ class AbstractExecutor {
   virtual void Init() = 0;
 
   /**
-   * Produces the next tuple from this executor.
+   * Produces the next tuple from this executor. The tuple may not own its data, in which case it is only valid until
+   * the next call to Init, Next or NextBatch of this executor; a caller that keeps it longer keeps a Materialize copy.
    * @param[out] tuple the next tuple produced by this executor
    * @param[out] rid the next tuple rid produced by this executor
    * @return true if a tuple was produced, false if there are no more tuples
    */
   virtual bool Next(Tuple *tuple, RID *rid) = 0;
 
+  /**
+   * Produces the next batch of tuples from this executor. By default this calls Next until the batch is full;
+   * executors that can produce many tuples more cheaply than one at a time override it. Calls to Next and
+   * NextBatch may be mixed, and continue from the same position. The tuples are valid until the batch is cleared.
+   * @param[out] batch cleared, then filled with up to its capacity of the next tuples
+   * @return true if at least one tuple was produced, false if there are no more tuples
+   */
+  virtual bool NextBatch(TupleBatch *batch) {
+    batch->Clear();
+    Tuple tuple;
+    RID rid;
+    while (!batch->IsFull() && Next(&tuple, &rid)) {
+      // The tuple is only valid until the next call to Next, so the batch keeps a copy in its arena.
+      batch->Append(Tuple(tuple, batch->GetArena()), rid);
+    }
+    return !batch->IsEmpty();
+  }
+
   /** @return the schema of the tuples that this executor produces */
   virtual const Schema *GetOutputSchema() = 0;
 
@@ -52,5 +75,10 @@ class AbstractExecutor {
 
  protected:
   ExecutorContext *exec_ctx_;
+  /**
+   * The memory of the tuples Next outputs. Executors reset it in Next once the tuples in it are no longer valid, so it
+   * only ever holds their latest output, not every tuple of the query.
+   */
+  Arena output_arena_{PAGE_SIZE};
 };
 }  // namespace bustub
@@ -13,144 +13,32 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "common/util/hash_util.h"
-#include "container/hash/hash_function.h"
+#include "execution/aggregation_hash_table.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
-#include "type/value_factory.h"
 
 namespace bustub {
-/**
- * A simplified hash table that has all the necessary functionality for aggregations.
- */
-class SimpleAggregationHashTable {
- public:
-  /**
-   * Create a new simplified aggregation hash table.
-   * @param agg_exprs the aggregation expressions
-   * @param agg_types the types of aggregations
-   */
-  SimpleAggregationHashTable(const std::vector<const AbstractExpression *> &agg_exprs,
-                             const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
-
-  /** @return the initial aggregrate value for this aggregation executor */
-  AggregateValue GenerateInitialAggregateValue() {
-    std::vector<Value> values;
-    for (const auto &agg_type : agg_types_) {
-      switch (agg_type) {
-        case AggregationType::CountAggregate:
-          // Count starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::SumAggregate:
-          // Sum starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::MinAggregate:
-          // Min starts at INT_MAX.
-          values.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX));
-          break;
-        case AggregationType::MaxAggregate:
-          // Max starts at INT_MIN.
-          values.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN));
-          break;
-      }
-    }
-    return {values};
-  }
-
-  /** Combines the input into the aggregation result. */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
-    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
-      switch (agg_types_[i]) {
-        case AggregationType::CountAggregate:
-          // Count increases by one.
-          result->aggregates_[i] = result->aggregates_[i].Add(ValueFactory::GetIntegerValue(1));
-          break;
-        case AggregationType::SumAggregate:
-          // Sum increases by addition.
-          result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i]);
-          break;
-        case AggregationType::MinAggregate:
-          // Min is just the min.
-          result->aggregates_[i] = result->aggregates_[i].Min(input.aggregates_[i]);
-          break;
-        case AggregationType::MaxAggregate:
-          // Max is just the max.
-          result->aggregates_[i] = result->aggregates_[i].Max(input.aggregates_[i]);
-          break;
-      }
-    }
-  }
-
-  /**
-   * Inserts a value into the hash table and then combines it with the current aggregation.
-   * @param agg_key the key to be inserted
-   * @param agg_val the value to be inserted
-   */
-  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht.count(agg_key) == 0) {
-      ht.insert({agg_key, GenerateInitialAggregateValue()});
-    }
-    CombineAggregateValues(&ht[agg_key], agg_val);
-  }
-
-  /**
-   * An iterator through the simplified aggregation hash table.
-   */
-  class Iterator {
-   public:
-    /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_(iter) {}
-
-    /** @return the key of the iterator */
-    const AggregateKey &Key() { return iter_->first; }
-
-    /** @return the value of the iterator */
-    const AggregateValue &Val() { return iter_->second; }
-
-    /** @return the iterator before it is incremented */
-    Iterator &operator++() {
-      ++iter_;
-      return *this;
-    }
-
-    /** @return true if both iterators are identical */
-    bool operator==(const Iterator &other) { return this->iter_ == other.iter_; }
-
-    /** @return true if both iterators are different */
-    bool operator!=(const Iterator &other) { return this->iter_ != other.iter_; }
-
-   private:
-    /** Aggregates map. */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
-  };
-
-  /** @return iterator to the start of the hash table */
-  Iterator Begin() { return Iterator{ht.cbegin()}; }
-
-  /** @return iterator to the end of the hash table */
-  Iterator End() { return Iterator{ht.cend()}; }
-
- private:
-  /** The hash table is just a map from aggregate keys to aggregate values. */
-  std::unordered_map<AggregateKey, AggregateValue> ht{};
-  /** The aggregate expressions that we have. */
-  const std::vector<const AbstractExpression *> &agg_exprs_;
-  /** The types of aggregations that we have. */
-  const std::vector<AggregationType> &agg_types_;
-};
 
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX) on the tuples of a child executor.
+ * The groups are kept in an AggregationHashTable, keyed by the serialized group by values.
+ *
+ * If the groups outgrow the executor context's memory budget, the table's groups are spilled with their partial
+ * aggregates into hash partitions in TmpTupleFiles, and the table starts over empty. Once the input is drained, each
+ * partition is re-aggregated on its own and its groups are output, repartitioning any that still does not fit. A
+ * spilled group is a few records that must each fit in a temporary page, holding its key with its running aggregates,
+ * with one distinct value or with one sketch; a group with a larger key or distinct value fails the query instead.
+ *
+ * Below a Gather, each worker pre-aggregates its own input into one table per hash partition, so that only partial
+ * aggregates rather than tuples change hands; if those tables outgrow the budget they are spilled too. After a
+ * barrier each worker merges the groups of its partition from every worker, and outputs them.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -172,32 +60,105 @@ class AggregationExecutor : public AbstractExecutor {
 
   bool Next(Tuple *tuple, RID *rid) override;
 
-  /** @return the tuple as an AggregateKey */
-  AggregateKey MakeKey(const Tuple *tuple) {
-    std::vector<Value> keys;
-    for (const auto &expr : plan_->GetGroupBys()) {
-      keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {keys};
-  }
-
-  /** @return the tuple as an AggregateValue */
-  AggregateValue MakeVal(const Tuple *tuple) {
-    std::vector<Value> vals;
-    for (const auto &expr : plan_->GetAggregates()) {
-      vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {vals};
-  }
+  bool NextBatch(TupleBatch *batch) override;
 
  private:
+  /** The number of partitions the spilled groups are split into. */
+  static constexpr uint32_t NUM_PARTITIONS = 8;
+  /** How many times a partition may be repartitioned; past this its groups are aggregated in memory regardless. */
+  static constexpr uint32_t MAX_PARTITION_LEVEL = 3;
+
+  /** A partition of spilled groups that still has to be re-aggregated. */
+  struct SpilledPartition {
+    std::unique_ptr<TmpTupleFile> file_;
+    /** The number of times these groups have been partitioned. */
+    uint32_t level_;
+  };
+
+  /**
+   * The partial aggregates the workers below a Gather exchange: partials_[worker][partition], and the groups a worker
+   * spilled, in spilled_[worker][partition] if it spilled any.
+   */
+  struct PartialExchange {
+    explicit PartialExchange(uint32_t num_workers) : partials_(num_workers), spilled_(num_workers) {}
+    std::vector<std::vector<AggregationHashTable>> partials_;
+    std::vector<std::vector<std::unique_ptr<TmpTupleFile>>> spilled_;
+  };
+
   /** The aggregation plan node. */
   const AggregationPlanNode *plan_;
   /** The child executor whose tuples we are aggregating. */
   std::unique_ptr<AbstractExecutor> child_;
-  /** Simple aggregation hash table. */
-  // Uncomment me! SimpleAggregationHashTable aht_;
-  /** Simple aggregation hash table iterator. */
-  // Uncomment me! SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** The groups. */
+  AggregationHashTable aht_;
+  /** The next group to output. */
+  size_t next_group_{0};
+  /** Scratch space for the serialized group key and the aggregate input of a tuple. */
+  std::vector<char> key_;
+  std::vector<Value> input_;
+  /** The bytes aht_ may hold before it is spilled. */
+  size_t budget_{0};
+  /** The partitions the groups are being spilled into, empty if nothing was spilled. */
+  std::vector<std::unique_ptr<TmpTupleFile>> partitions_;
+  /** The spilled partitions that are still to be re-aggregated. */
+  std::vector<SpilledPartition> pending_;
+
+  /** @return the group by values of the tuple, serialized into key_, and their hash */
+  hash_t MakeKey(const Tuple *tuple);
+
+  /** Evaluates the aggregate expressions on the tuple into input_. */
+  void MakeVal(const Tuple *tuple);
+
+  /** @return a new empty table for this plan's groups */
+  AggregationHashTable MakeTable() const;
+
+  /**
+   * @param hash the hash of a group key
+   * @param level the number of times the group has already been partitioned
+   * @return the spill partition the group belongs to; every level splits the groups independently of the previous ones
+   */
+  static uint32_t PartitionOf(hash_t hash, uint32_t level) { return HashUtil::Mix64(hash + level) % NUM_PARTITIONS; }
+
+  /** @return a new empty set of partition files */
+  std::vector<std::unique_ptr<TmpTupleFile>> MakePartitions();
+
+  /**
+   * Appends the records of a group to a spill file.
+   * @throws Exception if one of the records is larger than a temporary page, as with a very long group key
+   */
+  static void SpillGroup(const AggregationHashTable &table, size_t group, TmpTupleFile *file);
+
+  /** Moves the groups of a table into partition files, creating the files if there are none yet. */
+  void SpillTable(AggregationHashTable *table, std::vector<std::unique_ptr<TmpTupleFile>> *partitions, uint32_t level);
+
+  /** Spills aht_ if it holds more than the budget. */
+  void SpillIfFull(std::vector<std::unique_ptr<TmpTupleFile>> *partitions, uint32_t level) {
+    if (aht_.GetMemoryUsage() > budget_) {
+      SpillTable(&aht_, partitions, level);
+    }
+  }
+
+  /**
+   * Once all the groups have been added, spills what is left of aht_ as well if anything was spilled already, and
+   * queues the partitions to be re-aggregated.
+   */
+  void FinishSpill(std::vector<std::unique_ptr<TmpTupleFile>> *partitions, uint32_t level);
+
+  /** Re-aggregates the next spilled partition into aht_, or repartitions it if it still does not fit. */
+  void LoadNextPartition();
+
+  /**
+   * Below a Gather, builds the groups of this worker's hash partition: every worker pre-aggregates its input by
+   * partition, and then merges the partial aggregates of the partition it owns.
+   */
+  void AggregatePartition();
+
+  /**
+   * Produces the output tuple of the next group that satisfies the having clause.
+   * @param[out] tuple the output tuple
+   * @param arena the arena to build the output tuple in
+   * @return false if there are no more groups
+   */
+  bool NextGroup(Tuple *tuple, Arena *arena);
 };
 }  // namespace bustub
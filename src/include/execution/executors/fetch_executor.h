@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fetch_executor.h
+//
+// Identification: src/include/execution/executors/fetch_executor.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/fetch_plan.h"
+#include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+/**
+ * FetchExecutor reads the table tuples whose RIDs its child outputs, and outputs the child's columns together with
+ * the table's. Only the tuples that reach it are copied out of the table.
+ */
+class FetchExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new fetch executor.
+   * @param exec_ctx the executor context
+   * @param plan the fetch plan to be executed
+   * @param child the child executor that outputs the RIDs
+   */
+  FetchExecutor(ExecutorContext *exec_ctx, const FetchPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  bool NextBatch(TupleBatch *batch) override;
+
+ private:
+  /**
+   * Fetches the table tuple of a child tuple and evaluates the output over both.
+   * @param child_tuple the child tuple
+   * @param[out] tuple the output tuple
+   * @param[out] rid the RID of the table tuple
+   * @param arena the arena to build the output tuple in
+   * @return false if the table tuple no longer exists
+   */
+  bool Fetch(const Tuple &child_tuple, Tuple *tuple, RID *rid, Arena *arena);
+
+  /** The fetch plan node. */
+  const FetchPlanNode *plan_;
+  /** The child executor that outputs the RIDs. */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** The table to fetch from. */
+  TableMetadata *table_info_{nullptr};
+  /** The batch of child tuples being fetched. */
+  TupleBatch child_batch_;
+  /** Scratch space for the view of the fetched tuple and the output values. */
+  TupleView fetched_;
+  std::vector<Value> values_;
+};
+}  // namespace bustub
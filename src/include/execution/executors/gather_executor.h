@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "execution/exchange_queue.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/parallel_context.h"
+#include "execution/plans/gather_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * GatherExecutor builds one executor tree for the child plan per worker, each with its own ExecutorContext marking
+ * it as a worker of a shared ParallelContext, and runs them on the ExecutionEngine's thread pool. The workers' output
+ * is funneled through an ExchangeQueue to the calling thread.
+ *
+ * Partition-aware executors wait for each other at barriers, so all the workers must run at the same time: there are
+ * never more workers than idle pool threads, which the gather reserves before starting them. If the pool is busy, the
+ * gather runs with fewer workers than planned, down to a single one.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new gather executor.
+   * @param exec_ctx the executor context
+   * @param plan the gather plan to be executed
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan);
+
+  /** Stops the workers, which may still be running if the parent did not drain the gather. */
+  ~GatherExecutor() override;
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  bool NextBatch(TupleBatch *batch) override;
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
+
+ private:
+  /** The body of a worker: initializes and drains its executor tree into the exchange. */
+  void Work(uint32_t worker_id);
+
+  /** Closes the exchange, releases the workers from any barrier and waits for them to finish. */
+  void Stop();
+
+  /** The gather plan node to be executed. */
+  const GatherPlanNode *plan_;
+
+  std::unique_ptr<ParallelContext> parallel_ctx_;
+  /** Each worker's context and executor tree, indexed by worker id. */
+  std::vector<std::unique_ptr<ExecutorContext>> worker_ctxs_;
+  std::vector<std::unique_ptr<AbstractExecutor>> workers_;
+  std::unique_ptr<ExchangeQueue> queue_;
+
+  /** The batch being returned by Next, and the position of the next tuple in it. */
+  TupleBatch batch_;
+  size_t batch_idx_{0};
+};
+}  // namespace bustub
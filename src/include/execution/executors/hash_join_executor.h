@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_join_executor.h
+//
+// Identification: src/include/execution/executors/hash_join_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/hash_join_plan.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+/**
+ * HashJoinExecutor executes an equi-join. Init drains the build side, the child with the smaller estimated
+ * cardinality (the left one on a tie), into an in-memory hash table keyed on its join keys; Next streams the other
+ * child, the probe side, and probes the table with each of its tuples' join keys.
+ *
+ * If the build side outgrows the executor context's memory budget, the join turns into a hybrid hash join: both
+ * sides are hash partitioned into TmpTupleFiles, except for the first partition, which stays in memory for as long
+ * as it fits and is joined while the right child streams. The spilled partitions are then joined pair by pair,
+ * repartitioning any whose build side still does not fit.
+ *
+ * Below a Gather, the workers first exchange both inputs by join key hash, and each worker joins one partition.
+ */
+class HashJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new hash join executor.
+   * @param exec_ctx the executor context
+   * @param plan the hash join plan to be executed
+   * @param left_executor the child executor that produces the left side of the join
+   * @param right_executor the child executor that produces the right side of the join
+   */
+  HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
+                   std::unique_ptr<AbstractExecutor> &&left_executor,
+                   std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  bool NextBatch(TupleBatch *batch) override;
+
+ private:
+  /** The number of partitions each spilled input is split into. */
+  static constexpr uint32_t NUM_PARTITIONS = 8;
+  /** How many times a partition may be repartitioned; past this its keys are too skewed to split any further. */
+  static constexpr uint32_t MAX_PARTITION_LEVEL = 3;
+
+  /**
+   * The exchanges the workers below a Gather redistribute both sides of the join through. Each side may buffer half
+   * of a worker's budget before it spills.
+   */
+  struct JoinExchange {
+    JoinExchange(uint32_t num_workers, BufferPoolManager *bpm, size_t budget)
+        : build_(num_workers, bpm, budget / 2), probe_(num_workers, bpm, budget / 2) {}
+    PartitionExchange build_;
+    PartitionExchange probe_;
+  };
+
+  /** A pair of spilled partitions that must be joined with each other. */
+  struct PartitionPair {
+    std::unique_ptr<TmpTupleFile> build_;
+    std::unique_ptr<TmpTupleFile> probe_;
+    /** The number of times these tuples have been partitioned. */
+    uint32_t level_;
+  };
+
+  /**
+   * Evaluates the join keys of a tuple.
+   * @param tuple the tuple to evaluate on
+   * @param schema the schema of the tuple
+   * @param key_exprs the join key expressions of the tuple's side
+   * @return the tuple as a HashJoinKey
+   */
+  static HashJoinKey MakeKey(const Tuple *tuple, const Schema *schema,
+                             const std::vector<const AbstractExpression *> &key_exprs);
+
+  /**
+   * @param key a join key
+   * @param level the number of times the key's tuple has already been partitioned
+   * @return the partition the key belongs to; every level splits the keys independently of the previous ones
+   */
+  static uint32_t PartitionOf(const HashJoinKey &key, uint32_t level);
+
+  /** @return the number of bytes a tuple takes up in the hash table */
+  static size_t Footprint(const Tuple &tuple) { return sizeof(Tuple) + tuple.GetLength(); }
+
+  /** @return a new empty set of partition files */
+  std::vector<std::unique_ptr<TmpTupleFile>> MakePartitions();
+
+  /** @return the child whose tuples are hashed */
+  AbstractExecutor *BuildExecutor() { return build_right_ ? right_executor_.get() : left_executor_.get(); }
+
+  /** @return the child whose tuples probe the hash table */
+  AbstractExecutor *ProbeExecutor() { return build_right_ ? left_executor_.get() : right_executor_.get(); }
+
+  /** @return the output schema of the build child */
+  const Schema *BuildSchema() const {
+    return (build_right_ ? plan_->GetRightPlan() : plan_->GetLeftPlan())->OutputSchema();
+  }
+
+  /** @return the output schema of the probe child */
+  const Schema *ProbeSchema() const {
+    return (build_right_ ? plan_->GetLeftPlan() : plan_->GetRightPlan())->OutputSchema();
+  }
+
+  /** @return the join key expressions of the build child */
+  const std::vector<const AbstractExpression *> &BuildKeys() const {
+    return build_right_ ? plan_->GetRightKeys() : plan_->GetLeftKeys();
+  }
+
+  /** @return the join key expressions of the probe child */
+  const std::vector<const AbstractExpression *> &ProbeKeys() const {
+    return build_right_ ? plan_->GetLeftKeys() : plan_->GetRightKeys();
+  }
+
+  /**
+   * Adds a tuple of the build child to the hash table, spilling the build side if it outgrows the budget.
+   * @param build_tuple the tuple to add
+   * @param budget the bytes the hash table may hold
+   */
+  void AddBuildTuple(const Tuple &build_tuple, size_t budget);
+
+  /**
+   * Below a Gather, drains both children into the workers' exchange, then builds the hash table from the build tuples
+   * of this worker's partition.
+   */
+  void BuildPartition(size_t budget);
+
+  /**
+   * Refills probe_batch_ from the probe child, or below a Gather from this worker's partition of the probe side.
+   * @return false if there are no more probe tuples
+   */
+  bool NextProbeBatch();
+
+  /** Produces the next joined tuple, in the given arena; Next and NextBatch both go through here. */
+  bool Produce(Tuple *tuple, RID *rid, Arena *arena);
+
+  /** Inserts a build tuple, which must own its data, into the hash table. */
+  void InsertBuild(HashJoinKey &&key, Tuple &&tuple);
+
+  /**
+   * Moves the build tuples of the hash table into the build partitions. If keep_first is true, the tuples of the
+   * first partition stay in memory.
+   */
+  void SpillBuild(bool keep_first);
+
+  /**
+   * Looks up the build tuples matching a probe tuple, and makes them the current matches.
+   * @param key the join key of the probe tuple
+   */
+  void Probe(const HashJoinKey &key);
+
+  /**
+   * Loads the next pair of spilled partitions: the build side into the hash table, and the probe side as the
+   * source of probe tuples.
+   * @return false if there are no more partitions to join
+   */
+  bool LoadNextPartition();
+
+  /** The hash join plan node to be executed. */
+  const HashJoinPlanNode *plan_;
+  /** The left side of the join. */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  /** The right side of the join. */
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** Whether the right child is the build side, because it is estimated to be smaller than the left one. */
+  bool build_right_{false};
+  /** The build side, grouped by join key. */
+  std::unordered_map<HashJoinKey, std::vector<Tuple>> ht_;
+  /** The bytes held by ht_. */
+  size_t ht_bytes_{0};
+
+  /** Whether the build side was partitioned. */
+  bool spilled_{false};
+  /** Whether the first partition of the build side is still in ht_ rather than on disk. */
+  bool first_resident_{false};
+  /** The partitions of the build child. */
+  std::vector<std::unique_ptr<TmpTupleFile>> build_partitions_;
+  /** The partitions of the probe child. */
+  std::vector<std::unique_ptr<TmpTupleFile>> probe_partitions_;
+  /** Whether the probe child has been drained. */
+  bool probe_done_{false};
+  /** The spilled partitions that are still to be joined. */
+  std::vector<PartitionPair> pending_;
+  /** The probe side of the partition being joined, and its reader. */
+  std::unique_ptr<TmpTupleFile> probe_file_;
+  std::unique_ptr<TmpTupleFile::Reader> probe_reader_;
+
+  /**
+   * Below a Gather, the exchange of both inputs, the producer whose part of this worker's probe side is being read,
+   * and its reader.
+   */
+  std::shared_ptr<JoinExchange> exchange_;
+  uint32_t probe_producer_{0};
+  std::unique_ptr<PartitionExchange::Reader> exchange_reader_;
+
+  /** The batch of probe tuples being probed, and the next one to probe. */
+  TupleBatch probe_batch_;
+  size_t probe_batch_idx_{0};
+  /** The last probe tuple read back from a spilled partition. */
+  Tuple spilled_tuple_;
+  /** The current probe tuple, in probe_batch_ or spilled_tuple_. */
+  const Tuple *probe_tuple_{nullptr};
+  /** The build tuples matching probe_tuple_, or nullptr if there is no current probe tuple. */
+  const std::vector<Tuple> *matches_{nullptr};
+  /** The next entry of matches_ to join with probe_tuple_. */
+  size_t match_idx_{0};
+};
+}  // namespace bustub
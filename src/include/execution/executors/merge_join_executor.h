@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+/**
+ * MergeJoinExecutor joins two children sorted on their join keys by advancing them in lockstep. The right tuples
+ * sharing a key are buffered as a run, so that every left tuple with that key can be joined against all of them;
+ * a run is the only state kept, so no hash table is built.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new merge join executor.
+   * @param exec_ctx the executor context
+   * @param plan the merge join plan to be executed
+   * @param left_executor the child executor that produces the left side of the join, sorted on its join keys
+   * @param right_executor the child executor that produces the right side of the join, sorted on its join keys
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_executor,
+                    std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+ private:
+  /**
+   * Reads the next tuple with non-NULL join keys from a child.
+   * @param child the child to read from
+   * @param key_exprs the join key expressions of the child's side
+   * @param[out] tuple the tuple read
+   * @param[out] keys the join keys of the tuple
+   * @return false if the child is exhausted
+   */
+  static bool Advance(AbstractExecutor *child, const std::vector<const AbstractExpression *> &key_exprs,
+                      Tuple *tuple, std::vector<Value> *keys);
+
+  /** @return a negative number, zero or a positive number as lhs is smaller than, equal to or larger than rhs */
+  int Compare(const std::vector<Value> &lhs, const std::vector<Value> &rhs) const {
+    return CompareSortKeys(key_order_, lhs, rhs);
+  }
+
+  /** The merge join plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** The order both children are sorted in: ascending on every join key. */
+  std::vector<OrderBy> key_order_;
+
+  /** The current left tuple and its join keys. */
+  Tuple left_tuple_;
+  std::vector<Value> left_keys_;
+  bool has_left_{false};
+  /** The first right tuple that is not yet part of a run, and its join keys. */
+  Tuple right_tuple_;
+  std::vector<Value> right_keys_;
+  bool has_right_{false};
+  /** The right tuples sharing run_keys_, and the next one to join with the current left tuple. */
+  std::vector<Tuple> run_;
+  std::vector<Value> run_keys_;
+  size_t run_idx_{0};
+};
+}  // namespace bustub
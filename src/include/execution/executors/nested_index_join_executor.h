@@ -48,7 +48,31 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   bool Next(Tuple *tuple, RID *rid) override;
 
  private:
+  /** Number of outer tuples whose index lookups are issued together. */
+  static constexpr size_t BATCH_SIZE = 128;
+
+  /**
+   * Pulls the next batch of outer tuples and probes the index for all of them at once. Outer tuples with a NULL key
+   * are dropped, since they cannot match.
+   * @return false if the outer child is exhausted
+   */
+  bool FetchBatch();
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  /** The outer table child executor. */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The inner table and the index probed for it. */
+  TableMetadata *inner_table_info_{nullptr};
+  IndexInfo *index_info_{nullptr};
+  /** The side of the equality predicate that is evaluated on outer tuples to build the probe key. */
+  const AbstractExpression *outer_key_expr_{nullptr};
+
+  /** The current batch of outer tuples and, for each of them, the RIDs of inner tuples with a matching key. */
+  std::vector<Tuple> outer_batch_;
+  std::vector<std::vector<RID>> inner_rids_;
+  /** Position of the next (outer, inner) pair to emit. */
+  size_t outer_idx_{0};
+  size_t inner_idx_{0};
 };
 }  // namespace bustub
@@ -48,5 +48,13 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
  private:
   /** The NestedLoop plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
+  /** The outer side of the join. */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  /** The inner side of the join, re-initialized once per outer tuple. */
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** The current outer tuple. */
+  Tuple left_tuple_;
+  /** Whether left_tuple_ holds a tuple that is still being joined. */
+  bool has_left_{false};
 };
 }  // namespace bustub
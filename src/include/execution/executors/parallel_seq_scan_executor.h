@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_seq_scan_executor.h
+//
+// Identification: src/include/execution/executors/parallel_seq_scan_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "execution/compiled_predicate.h"
+#include "execution/exchange_queue.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/parallel_seq_scan_plan.h"
+#include "storage/table/page_range_dispenser.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * ParallelSeqScanExecutor scans a table with several workers on the ExecutionEngine's thread pool. The workers take
+ * pages from a PageRangeDispenser, filter and project their tuples, and hand the results over in batches through an
+ * ExchangeQueue, which Next and NextBatch drain on the calling thread.
+ *
+ * It cannot run below a GatherExecutor, whose workers would hold the pool threads its own workers need.
+ */
+class ParallelSeqScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new parallel sequential scan executor.
+   * @param exec_ctx the executor context
+   * @param plan the parallel sequential scan plan to be executed
+   */
+  ParallelSeqScanExecutor(ExecutorContext *exec_ctx, const ParallelSeqScanPlanNode *plan);
+
+  /** Stops the workers, which may still be running if the parent did not drain the scan. */
+  ~ParallelSeqScanExecutor() override;
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  bool NextBatch(TupleBatch *batch) override;
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
+
+ private:
+  /** The body of a worker thread: scans the pages the dispenser hands it until there are none left. */
+  void Work(uint32_t worker_id);
+
+  /**
+   * Projects the tuples of a page that satisfy the predicate, reading them in place.
+   * @param page_id the page to scan
+   * @param[out] matches the projected matching tuples
+   * @param[out] rids the RIDs of the matching tuples
+   */
+  void ScanPage(page_id_t page_id, std::vector<Tuple> *matches, std::vector<RID> *rids) const;
+
+  /** Closes the exchange and waits for the workers to finish. */
+  void Stop();
+
+  /** The parallel sequential scan plan node to be executed. */
+  const ParallelSeqScanPlanNode *plan_;
+  /** The table being scanned. */
+  TableMetadata *table_info_{nullptr};
+  /** The plan's predicate, compiled against the table schema. */
+  std::unique_ptr<CompiledPredicate> predicate_;
+
+  std::unique_ptr<PageRangeDispenser> dispenser_;
+  std::unique_ptr<ExchangeQueue> queue_;
+
+  /** The batch being returned by Next, and the position of the next tuple in it. */
+  TupleBatch batch_;
+  size_t batch_idx_{0};
+};
+}  // namespace bustub
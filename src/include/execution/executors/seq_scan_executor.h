@@ -12,17 +12,23 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "execution/compiled_predicate.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/page/table_page.h"
+#include "storage/table/page_range_dispenser.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * SeqScanExecutor executes a sequential scan over a table.
+ * SeqScanExecutor executes a sequential scan over a table, a page at a time: the tuples of a page are filtered and
+ * projected in place, under the page's read latch, and only the output tuples are copied. Below a Gather, the
+ * workers' scans each read a share of the pages.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -37,10 +43,57 @@ class SeqScanExecutor : public AbstractExecutor {
 
   bool Next(Tuple *tuple, RID *rid) override;
 
+  bool NextBatch(TupleBatch *batch) override;
+
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
 
  private:
+  /**
+   * Projects a tuple of the table onto the output schema.
+   * @param raw the tuple as stored in the table
+   * @param values scratch space for the projected values
+   * @param[out] tuple the projected tuple, in output_arena_
+   */
+  void Project(const Tuple &raw, std::vector<Value> *values, Tuple *tuple);
+
+  /**
+   * @return true if the predicate compares an INTEGER, BIGINT or DECIMAL column with a constant of the column's
+   * domain, so that whole pages can be filtered with SimdFilter
+   */
+  bool CanFilterPages() const;
+
+  /**
+   * Scans the following pages until one has matching tuples, and projects only those into page_matches_. The
+   * tuples are read in place, from the latched page, rather than copied out of it first.
+   * @return false if no page left has a match
+   */
+  bool ScanNextPage();
+
+  /** Gathers the predicate's column out of the page and filters it, leaving the selected slots in selection_. */
+  template <typename T>
+  uint32_t FilterColumn(const TablePage *page, T constant);
+
   /** The sequential scan plan node to be executed. */
   const SeqScanPlanNode *plan_;
+  /** The table being scanned. */
+  TableMetadata *table_info_{nullptr};
+  /** The plan's predicate, compiled against the table schema. */
+  std::unique_ptr<CompiledPredicate> predicate_;
+  /** True if each page is filtered with SimdFilter rather than tuple by tuple. */
+  bool filter_pages_{false};
+  /** Below a Gather, hands out the pages this worker scans; otherwise the scan follows next_page_id_. */
+  std::shared_ptr<PageRangeDispenser> dispenser_;
+  /** The next page to scan. */
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  /** The slots of the live tuples of the page being filtered, and the positions among them that matched. */
+  std::vector<uint32_t> slots_;
+  std::vector<uint32_t> selection_;
+  /**
+   * The projected matching tuples of the last scanned page and their RIDs, and the next one to return. The tuples are
+   * in output_arena_, which is reset when the next page is scanned.
+   */
+  std::vector<Tuple> page_matches_;
+  std::vector<RID> page_rids_;
+  size_t match_idx_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.h
+//
+// Identification: src/include/execution/executors/sort_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/sort_plan.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortExecutor executes an external merge sort. Init drains the child, sorting the tuples in memory. Whenever the
+ * tuples outgrow the executor context's memory budget, they are sorted and written out as a run. If any runs were
+ * written, Next merges them with a loser tree, first merging groups of runs until they can all be merged at once.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new sort executor.
+   * @param exec_ctx the executor context
+   * @param plan the sort plan to be executed
+   * @param child the child executor whose tuples are sorted
+   */
+  SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+ private:
+  /** A tuple together with its evaluated sort key. */
+  struct SortEntry {
+    std::vector<Value> keys_;
+    Tuple tuple_;
+  };
+
+  /** A run being merged, positioned at its smallest unmerged tuple. */
+  struct MergeSource {
+    std::unique_ptr<TmpTupleFile::Reader> reader_;
+    SortEntry entry_;
+    bool exhausted_;
+  };
+
+  /** @return the tuple with its sort key */
+  SortEntry MakeEntry(Tuple &&tuple);
+
+  /** @return the number of bytes an entry takes up in memory */
+  size_t Footprint(const SortEntry &entry) const;
+
+  /** Sorts the in-memory entries and writes them out as a run. */
+  void SpillRun();
+
+  /** Reads the next entry of a merge source, or marks it exhausted. */
+  void Advance(MergeSource *source);
+
+  /** @return true if source a's current entry should be output before source b's */
+  bool Beats(size_t a, size_t b) const;
+
+  /** Builds the loser tree over the sources; returns the winner of the subtree rooted at node. */
+  size_t BuildTree(size_t node);
+
+  /** Starts merging the given runs, replacing any merge in progress. */
+  void StartMerge(std::vector<std::unique_ptr<TmpTupleFile>> &&runs);
+
+  /**
+   * Pops the smallest tuple of the merge in progress.
+   * @param[out] tuple the smallest tuple
+   * @return false if all the runs being merged are exhausted
+   */
+  bool NextMerged(Tuple *tuple);
+
+  /** The sort plan node to be executed. */
+  const SortPlanNode *plan_;
+  /** The child executor whose tuples are sorted. */
+  std::unique_ptr<AbstractExecutor> child_;
+
+  /** The tuples sorted in memory, output directly if nothing was spilled. */
+  std::vector<SortEntry> entries_;
+  size_t entries_bytes_{0};
+  /** The next entry of entries_ to output. */
+  size_t entry_idx_{0};
+
+  /** The sorted runs written out, oldest first. */
+  std::deque<std::unique_ptr<TmpTupleFile>> runs_;
+  /** The runs being merged, and the merge's sources in the same order. */
+  std::vector<std::unique_ptr<TmpTupleFile>> merging_;
+  std::vector<MergeSource> sources_;
+  /** The loser tree over sources_: tree_[0] is the winner, each other node holds the loser of its match. */
+  std::vector<size_t> tree_;
+};
+}  // namespace bustub
@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregate_executor.h
+//
+// Identification: src/include/execution/executors/streaming_aggregate_executor.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/aggregation_hash_table.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/streaming_aggregate_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+/**
+ * StreamingAggregateExecutor aggregates a child that produces the tuples of each group next to each other. It only
+ * keeps the current group, in a one-group AggregationHashTable that is reset in place for every group and combined
+ * into without a lookup, and outputs the group as soon as a tuple with a different key arrives, so its output is in
+ * the child's order. Keys are compared by their serialized bytes, like
+ * AggregationExecutor's, so the NULLs of a column make up one group.
+ */
+class StreamingAggregateExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new streaming aggregate executor.
+   * @param exec_ctx the context that the aggregation should be performed in
+   * @param plan the streaming aggregate plan node
+   * @param child the child executor, grouped on the group by expressions
+   */
+  StreamingAggregateExecutor(ExecutorContext *exec_ctx, const StreamingAggregatePlanNode *plan,
+                             std::unique_ptr<AbstractExecutor> &&child);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  bool NextBatch(TupleBatch *batch) override;
+
+ private:
+  /** @return an empty table over the plan's group bys and aggregates */
+  AggregationHashTable MakeTable() const;
+
+  /** Serializes the group by values of a tuple into next_key_. */
+  void MakeKey(const Tuple *tuple);
+
+  /** Starts a new current group, whose key is in next_key_. */
+  void StartGroup();
+
+  /** Combines a tuple into the current group. */
+  void CombineTuple(const Tuple *tuple);
+
+  /**
+   * Evaluates the having clause and the output of the current group.
+   * @param[out] tuple the output tuple
+   * @param arena the arena to build the output tuple in
+   * @return false if the group does not satisfy the having clause
+   */
+  bool FinishGroup(Tuple *tuple, Arena *arena);
+
+  /** Produces the output tuple of the next group that satisfies the having clause, in the given arena. */
+  bool NextGroup(Tuple *tuple, Arena *arena);
+
+  /** The streaming aggregate plan node. */
+  const StreamingAggregatePlanNode *plan_;
+  /** The child executor whose tuples we are aggregating. */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** The batch of child tuples being aggregated, and the next one to aggregate. */
+  TupleBatch batch_;
+  size_t batch_idx_{0};
+  bool child_done_{false};
+  /** Whether there is a current group. */
+  bool has_group_{false};
+  /** The serialized key of the current group, and a table holding just that group. */
+  std::vector<char> key_;
+  AggregationHashTable group_;
+  /** Scratch space for the serialized key and the aggregate input of the tuple being aggregated. */
+  std::vector<char> next_key_;
+  std::vector<Value> input_;
+};
+}  // namespace bustub
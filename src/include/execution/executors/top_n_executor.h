@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_executor.h
+//
+// Identification: src/include/execution/executors/top_n_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/top_n_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TopNExecutor drains its child through a max-heap bounded at offset + limit tuples, so it only ever holds the
+ * tuples that can still make the cut instead of sorting the whole input.
+ */
+class TopNExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new top-n executor.
+   * @param exec_ctx the executor context
+   * @param plan the top-n plan to be executed
+   * @param child the child executor whose tuples are ranked
+   */
+  TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  void Init() override;
+
+  bool Next(Tuple *tuple, RID *rid) override;
+
+ private:
+  /** A tuple with its sort key and arrival order; ties on the key go to the earlier tuple, as in a stable sort. */
+  struct HeapEntry {
+    std::vector<Value> keys_;
+    size_t seq_;
+    Tuple tuple_;
+  };
+
+  /** @return true if a sorts before b */
+  bool Before(const HeapEntry &a, const HeapEntry &b) const;
+
+  /** The top-n plan node to be executed. */
+  const TopNPlanNode *plan_;
+  /** The child executor whose tuples are ranked. */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** The top tuples, in sorted order once Init is done. */
+  std::vector<HeapEntry> top_;
+  /** The next entry of top_ to output. */
+  size_t top_idx_{0};
+};
+}  // namespace bustub
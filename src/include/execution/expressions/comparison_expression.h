@@ -18,6 +18,7 @@
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
 #include "storage/table/tuple.h"
+#include "type/type_dispatch.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -53,21 +54,25 @@ class ComparisonExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  /** @return the type of comparison performed */
+  ComparisonType GetComparisonType() const { return comp_type_; }
+
  private:
+  /** Compares through TypeDispatch, which skips the virtual Type when both sides have the same fixed-size type. */
   CmpBool PerformComparison(const Value &lhs, const Value &rhs) const {
     switch (comp_type_) {
       case ComparisonType::Equal:
-        return lhs.CompareEquals(rhs);
+        return TypeDispatch::CompareEquals(lhs, rhs);
       case ComparisonType::NotEqual:
-        return lhs.CompareNotEquals(rhs);
+        return TypeDispatch::CompareNotEquals(lhs, rhs);
       case ComparisonType::LessThan:
-        return lhs.CompareLessThan(rhs);
+        return TypeDispatch::CompareLessThan(lhs, rhs);
       case ComparisonType::LessThanOrEqual:
-        return lhs.CompareLessThanEquals(rhs);
+        return TypeDispatch::CompareLessThanEquals(lhs, rhs);
       case ComparisonType::GreaterThan:
-        return lhs.CompareGreaterThan(rhs);
+        return TypeDispatch::CompareGreaterThan(lhs, rhs);
       case ComparisonType::GreaterThanOrEqual:
-        return lhs.CompareGreaterThanEquals(rhs);
+        return TypeDispatch::CompareGreaterThanEquals(lhs, rhs);
       default:
         BUSTUB_ASSERT(false, "Unsupported comparison type.");
     }
@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// row_id_expression.h
+//
+// Identification: src/include/execution/expressions/row_id_expression.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+/**
+ * RowIdExpression evaluates to the RID of a table tuple, as a BIGINT from RID::Get. A scan can output it instead of
+ * the columns that are only needed at the end of the plan, and a Fetch reads them from the table by it.
+ */
+class RowIdExpression : public AbstractExpression {
+ public:
+  /** Creates a new row id expression. */
+  RowIdExpression() : AbstractExpression({}, TypeId::BIGINT) {}
+
+  Value Evaluate(const Tuple *tuple, const Schema *schema) const override {
+    return ValueFactory::GetBigIntValue(tuple->GetRid().Get());
+  }
+
+  Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
+                     const Schema *right_schema) const override {
+    BUSTUB_ASSERT(false, "Row ids are only read from table tuples.");
+  }
+
+  Value EvaluateAggregate(const std::vector<Value> &group_bys, const std::vector<Value> &aggregates) const override {
+    BUSTUB_ASSERT(false, "Row ids are only read from table tuples.");
+  }
+};
+}  // namespace bustub
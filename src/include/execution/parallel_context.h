@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_context.h
+//
+// Identification: src/include/execution/parallel_context.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "common/util/hash_util.h"
+#include "execution/plans/abstract_plan.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * PartitionExchange redistributes tuples among the workers of a parallel plan: every worker adds the tuples it
+ * produced to the partition of the worker that should process them, and after a barrier every worker reads its own
+ * partition from all the producers. Each producer only writes its own buffers, so adding takes no latch.
+ *
+ * A producer keeps its tuples in memory up to a budget; past it, it moves all of them into one TmpTupleFile per
+ * partition and starts over, so that a large input is spilled rather than held in memory until the barrier.
+ */
+class PartitionExchange {
+ public:
+  /**
+   * Creates an empty exchange.
+   * @param num_workers the number of producers and partitions
+   * @param bpm the buffer pool manager the spilled tuples are written to
+   * @param budget the bytes each producer may buffer before it spills
+   */
+  PartitionExchange(uint32_t num_workers, BufferPoolManager *bpm, size_t budget)
+      : bpm_(bpm),
+        budget_(budget),
+        buffers_(num_workers, std::vector<std::vector<Tuple>>(num_workers)),
+        buffered_bytes_(num_workers, 0),
+        spilled_(num_workers) {}
+
+  DISALLOW_COPY_AND_MOVE(PartitionExchange);
+
+  /** Adds a copy that owns its data of a tuple produced by a worker to a partition. */
+  void Add(uint32_t producer, uint32_t partition, const Tuple &tuple);
+
+  /** Signals that a producer has added all its tuples; it must be called before the barrier. */
+  void Finish(uint32_t producer);
+
+  /** @return the number of producers */
+  uint32_t GetNumProducers() const { return buffers_.size(); }
+
+  /**
+   * Reader scans the tuples a producer added to a partition: first the ones it spilled, then the ones it kept in
+   * memory. It is only valid once every producer is past the barrier.
+   */
+  class Reader {
+   public:
+    Reader(const PartitionExchange *exchange, uint32_t producer, uint32_t partition);
+
+    DISALLOW_COPY_AND_MOVE(Reader);
+
+    ~Reader() = default;
+
+    /** @return the next tuple, valid until the next call, or nullptr if there are no more */
+    const Tuple *Next();
+
+   private:
+    std::unique_ptr<TmpTupleFile::Reader> spilled_;
+    /** The tuple last read from spilled_. */
+    Tuple spilled_tuple_;
+    const std::vector<Tuple> *buffer_;
+    size_t buffer_idx_{0};
+  };
+
+  /** @return a reader of the tuples a producer added to a partition */
+  std::unique_ptr<Reader> MakeReader(uint32_t producer, uint32_t partition) const {
+    return std::make_unique<Reader>(this, producer, partition);
+  }
+
+ private:
+  /** Moves the tuples a producer buffered into its spill files, creating them if there are none yet. */
+  void Spill(uint32_t producer);
+
+  BufferPoolManager *bpm_;
+  size_t budget_;
+  /** buffers_[producer][partition] */
+  std::vector<std::vector<std::vector<Tuple>>> buffers_;
+  /** The bytes each producer holds in buffers_. */
+  std::vector<size_t> buffered_bytes_;
+  /** spilled_[producer][partition], empty for a producer that never spilled. */
+  std::vector<std::vector<std::unique_ptr<TmpTupleFile>>> spilled_;
+};
+
+/**
+ * ParallelContext is the state shared by the workers that run copies of the same plan fragment under a
+ * GatherExecutor. Each worker's ExecutorContext points to it together with the worker's id.
+ *
+ * Partition-aware executors use it to agree on the partition each key belongs to, to share one object per plan
+ * node (a PageRangeDispenser, a PartitionExchange), and to wait for each other at a barrier. Every worker runs the
+ * same plan, so every worker passes the same barriers in the same order.
+ */
+class ParallelContext {
+ public:
+  explicit ParallelContext(uint32_t num_workers) : num_workers_(num_workers) {}
+
+  DISALLOW_COPY_AND_MOVE(ParallelContext);
+
+  /** @return the number of workers */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
+  /** @return the worker that owns the partition of a key with the given hash */
+  uint32_t PartitionOf(hash_t hash) const {
+    // Salted, so that the executors that also partition by the key hash when they spill still spread the keys a
+    // worker owns over all their partitions.
+    return HashUtil::Mix64(hash ^ PARTITION_SALT) % num_workers_;
+  }
+
+  /**
+   * @param plan the plan node the object belongs to
+   * @param make creates the object, called by the first worker to ask
+   * @return the object every worker gets for the plan node
+   */
+  template <typename T, typename Make>
+  std::shared_ptr<T> GetShared(const AbstractPlanNode *plan, Make &&make) {
+    std::scoped_lock latch(latch_);
+    auto &shared = shared_[plan];
+    if (shared == nullptr) {
+      shared = make();
+    }
+    return std::static_pointer_cast<T>(shared);
+  }
+
+  /**
+   * Blocks until every worker has arrived.
+   * @throws Exception if the workers were aborted, since the missing workers would never arrive
+   */
+  void ArriveAndWait();
+
+  /** Releases the workers waiting at the barrier, and every later arrival, with an exception. */
+  void Abort();
+
+ private:
+  static constexpr uint64_t PARTITION_SALT = 0x9e3779b97f4a7c15ULL;
+
+  uint32_t num_workers_;
+  std::mutex latch_;
+  std::unordered_map<const AbstractPlanNode *, std::shared_ptr<void>> shared_;
+  /** Signaled when the last worker arrives or the workers are aborted. */
+  std::condition_variable barrier_cv_;
+  uint32_t num_arrived_{0};
+  /** Counts completed barriers, so that a worker racing ahead to the next barrier is not let through this one. */
+  uint64_t generation_{0};
+  bool aborted_{false};
+};
+
+}  // namespace bustub
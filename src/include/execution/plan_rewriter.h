@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_rewriter.h
+//
+// Identification: src/include/execution/plan_rewriter.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+/**
+ * PlanRewriter replaces plan nodes with cheaper equivalents. Plan nodes are immutable, so every rewrite returns
+ * either the plan it was given or a new node that shares the original's children; the rewriter owns the nodes it
+ * creates, and they live as long as it does.
+ */
+class PlanRewriter {
+ public:
+  /**
+   * Fuses a Limit directly over a Sort into a TopN over the Sort's child.
+   * @param plan the plan to rewrite
+   * @return the TopN plan, or plan itself if it is not a Limit over a Sort
+   */
+  const AbstractPlanNode *RewriteSortLimitAsTopN(const AbstractPlanNode *plan);
+
+  /**
+   * Turns a single-column equi-join whose children are both B+ tree index scans, each ordered on its side's join
+   * column, into a merge join. The join may be a HashJoin or a NestedLoopJoin whose predicate is the equality.
+   * @param plan the plan to rewrite
+   * @param catalog the catalog the scanned indexes are registered in
+   * @return the MergeJoin plan, or plan itself if the rewrite does not apply
+   */
+  const AbstractPlanNode *RewriteJoinAsMergeJoin(const AbstractPlanNode *plan, Catalog *catalog);
+
+  /**
+   * Turns an aggregation whose child is a B+ tree index scan into a streaming aggregation, if the group bys are the
+   * leading columns of the index key in any order, so that the tuples of each group come out next to each other.
+   * @param plan the plan to rewrite
+   * @param catalog the catalog the scanned index is registered in
+   * @return the StreamingAggregate plan, or plan itself if the rewrite does not apply
+   */
+  const AbstractPlanNode *RewriteAggregationAsStreaming(const AbstractPlanNode *plan, Catalog *catalog);
+
+ private:
+  /**
+   * @param plan a plan whose output is consumed in order
+   * @param key_exprs expressions evaluated on the plan's output
+   * @param catalog the catalog the scanned index is registered in
+   * @return true if plan scans a B+ tree index whose leading key columns are, in any order, the columns key_exprs
+   * read
+   */
+  static bool IsIndexOrderedOn(const AbstractPlanNode *plan, const std::vector<const AbstractExpression *> &key_exprs,
+                               Catalog *catalog);
+
+  /** The plan nodes created by rewrites. */
+  std::vector<std::unique_ptr<AbstractPlanNode>> plans_;
+};
+}  // namespace bustub
@@ -21,12 +21,23 @@
 
 namespace bustub {
 
-/** AggregationType enumerates all the possible aggregation functions in our system. */
-enum class AggregationType { CountAggregate, SumAggregate, MinAggregate, MaxAggregate };
+/**
+ * AggregationType enumerates all the possible aggregation functions in our system. AVG produces a DECIMAL, and the
+ * approximate distinct count is estimated with a HyperLogLog sketch.
+ */
+enum class AggregationType {
+  CountAggregate,
+  SumAggregate,
+  MinAggregate,
+  MaxAggregate,
+  AvgAggregate,
+  CountDistinctAggregate,
+  ApproxCountDistinctAggregate
+};
 
 /**
  * AggregationPlanNode represents the various SQL aggregation functions.
- * For example, COUNT(), SUM(), MIN() and MAX().
+ * For example, COUNT(), SUM(), MIN(), MAX(), AVG() and COUNT(DISTINCT).
  * To simplfiy this project, AggregationPlanNode must always have exactly one child.
  */
 class AggregationPlanNode : public AbstractPlanNode {
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fetch_plan.h
+//
+// Identification: src/include/execution/plans/fetch_plan.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/catalog.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+/**
+ * FetchPlanNode materializes the columns of a table late. Its child outputs the RIDs of the table's tuples as a
+ * column, from a RowIdExpression in a scan, along with whatever columns the plan needed so far; the fetch reads each
+ * surviving tuple from the table by its RID. The output columns are evaluated as a join of the child tuple (tuple
+ * index 0) and the table tuple (tuple index 1), so a plan over several tables can fetch from each of them in turn.
+ * Tuples that were deleted since the child saw their RIDs are skipped.
+ */
+class FetchPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new fetch plan node.
+   * @param output_schema the output format of this plan node
+   * @param child the plan that outputs the RIDs of the tuples to fetch
+   * @param table_oid the identifier of the table to fetch from
+   * @param rid_col_idx the index of the RID column in the child's output schema
+   */
+  FetchPlanNode(const Schema *output_schema, const AbstractPlanNode *child, table_oid_t table_oid,
+                uint32_t rid_col_idx)
+      : AbstractPlanNode(output_schema, {child}), table_oid_(table_oid), rid_col_idx_(rid_col_idx) {}
+
+  PlanType GetType() const override { return PlanType::Fetch; }
+
+  /** @return the plan that outputs the RIDs of the tuples to fetch */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Fetch should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  /** @return the identifier of the table to fetch from */
+  table_oid_t GetTableOid() const { return table_oid_; }
+
+  /** @return the index of the RID column in the child's output schema */
+  uint32_t GetRidColIdx() const { return rid_col_idx_; }
+
+ private:
+  /** The table to fetch from. */
+  table_oid_t table_oid_;
+  /** The child column holding the RIDs. */
+  uint32_t rid_col_idx_;
+};
+
+}  // namespace bustub
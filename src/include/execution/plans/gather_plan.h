@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_plan.h
+//
+// Identification: src/include/execution/plans/gather_plan.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * GatherPlanNode runs its child plan as several workers in parallel and outputs the union of their tuples, in no
+ * particular order. Each worker runs its own copy of the child plan, in which the partition-aware executors split
+ * the work: a sequential scan reads a share of the pages, and an aggregation or a hash join first redistributes its
+ * input so that each worker handles the keys of one hash partition.
+ *
+ * The child plan may contain sequential scans, fetches, aggregations and hash joins. Executors that re-initialize
+ * their children, such as the nested loop join, and other Gathers or parallel scans are not supported below a Gather.
+ */
+class GatherPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new gather plan node.
+   * @param output_schema the output format of this plan node, the same as the child's
+   * @param child the plan fragment each worker runs
+   * @param num_workers the number of workers, or 0 for one per thread of the engine's pool
+   */
+  GatherPlanNode(const Schema *output_schema, const AbstractPlanNode *child, uint32_t num_workers = 0)
+      : AbstractPlanNode(output_schema, {child}), num_workers_(num_workers) {}
+
+  PlanType GetType() const override { return PlanType::Gather; }
+
+  /** @return the plan fragment each worker runs */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Gather should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  /** @return the number of workers, or 0 for one per thread of the engine's pool */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
+ private:
+  uint32_t num_workers_;
+};
+
+}  // namespace bustub
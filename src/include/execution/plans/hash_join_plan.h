@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_join_plan.h
+//
+// Identification: src/include/execution/plans/hash_join_plan.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * HashJoinPlanNode represents an equi-join of its left and right children on pairs of key
+ * expressions. The executor hashes whichever child is estimated to be smaller and streams
+ * the other one past it; the output is the same either way.
+ */
+class HashJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new hash join plan node.
+   * @param output_schema the output format of this hash join node
+   * @param children the left and right children plans
+   * @param left_key_exprs the join key expressions, evaluated on left tuples
+   * @param right_key_exprs the join key expressions, evaluated on right tuples; pairs up with left_key_exprs
+   * @param predicate an optional residual predicate checked on joined pairs, tuples are joined if
+   * predicate(tuple) = true or predicate = nullptr
+   */
+  HashJoinPlanNode(const Schema *output_schema, std::vector<const AbstractPlanNode *> &&children,
+                   std::vector<const AbstractExpression *> &&left_key_exprs,
+                   std::vector<const AbstractExpression *> &&right_key_exprs, const AbstractExpression *predicate)
+      : AbstractPlanNode(output_schema, std::move(children)),
+        left_key_exprs_(std::move(left_key_exprs)),
+        right_key_exprs_(std::move(right_key_exprs)),
+        predicate_(predicate) {
+    BUSTUB_ASSERT(left_key_exprs_.size() == right_key_exprs_.size(), "Join keys must pair up.");
+  }
+
+  PlanType GetType() const override { return PlanType::HashJoin; }
+
+  /** @return the residual predicate to be used in the hash join */
+  const AbstractExpression *Predicate() const { return predicate_; }
+
+  /** @return the left plan node of the hash join */
+  const AbstractPlanNode *GetLeftPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Hash joins should have exactly two children plans.");
+    return GetChildAt(0);
+  }
+
+  /** @return the right plan node of the hash join */
+  const AbstractPlanNode *GetRightPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Hash joins should have exactly two children plans.");
+    return GetChildAt(1);
+  }
+
+  /** @return the join key expressions evaluated on the left child */
+  const std::vector<const AbstractExpression *> &GetLeftKeys() const { return left_key_exprs_; }
+
+  /** @return the join key expressions evaluated on the right child */
+  const std::vector<const AbstractExpression *> &GetRightKeys() const { return right_key_exprs_; }
+
+ private:
+  std::vector<const AbstractExpression *> left_key_exprs_;
+  std::vector<const AbstractExpression *> right_key_exprs_;
+  /** The residual join predicate. */
+  const AbstractExpression *predicate_;
+};
+
+struct HashJoinKey {
+  std::vector<Value> keys_;
+
+  /**
+   * Compares two join keys for equality. NULL never equals anything, so keys containing NULL never match.
+   * @param other the other join key to be compared with
+   * @return true if both join keys have equivalent values, false otherwise
+   */
+  bool operator==(const HashJoinKey &other) const {
+    for (uint32_t i = 0; i < other.keys_.size(); i++) {
+      if (keys_[i].CompareEquals(other.keys_[i]) != CmpBool::CmpTrue) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** @return true if any of the key values is NULL */
+  bool HasNull() const {
+    for (const auto &key : keys_) {
+      if (key.IsNull()) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+}  // namespace bustub
+
+namespace std {
+
+/**
+ * Implements std::hash on HashJoinKey.
+ */
+template <>
+struct hash<bustub::HashJoinKey> {
+  std::size_t operator()(const bustub::HashJoinKey &join_key) const {
+    size_t curr_hash = 0;
+    for (const auto &key : join_key.keys_) {
+      if (!key.IsNull()) {
+        curr_hash = bustub::HashUtil::CombineHashes(curr_hash, bustub::HashUtil::HashValue(&key));
+      }
+    }
+    return curr_hash;
+  }
+};
+
+}  // namespace std
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_plan.h
+//
+// Identification: src/include/execution/plans/merge_join_plan.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinPlanNode represents an equi-join of two children that both produce their tuples in ascending order of
+ * their join keys, e.g. index scans on the join columns.
+ */
+class MergeJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new merge join plan node.
+   * @param output_schema the output format of this merge join node
+   * @param children the left and right children plans, each sorted on its join keys
+   * @param left_key_exprs the join key expressions, evaluated on left tuples
+   * @param right_key_exprs the join key expressions, evaluated on right tuples; pairs up with left_key_exprs
+   * @param predicate an optional residual predicate checked on joined pairs, tuples are joined if
+   * predicate(tuple) = true or predicate = nullptr
+   */
+  MergeJoinPlanNode(const Schema *output_schema, std::vector<const AbstractPlanNode *> &&children,
+                    std::vector<const AbstractExpression *> &&left_key_exprs,
+                    std::vector<const AbstractExpression *> &&right_key_exprs, const AbstractExpression *predicate)
+      : AbstractPlanNode(output_schema, std::move(children)),
+        left_key_exprs_(std::move(left_key_exprs)),
+        right_key_exprs_(std::move(right_key_exprs)),
+        predicate_(predicate) {
+    BUSTUB_ASSERT(left_key_exprs_.size() == right_key_exprs_.size(), "Join keys must pair up.");
+  }
+
+  PlanType GetType() const override { return PlanType::MergeJoin; }
+
+  /** @return the residual predicate to be used in the merge join */
+  const AbstractExpression *Predicate() const { return predicate_; }
+
+  /** @return the left plan node of the merge join */
+  const AbstractPlanNode *GetLeftPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Merge joins should have exactly two children plans.");
+    return GetChildAt(0);
+  }
+
+  /** @return the right plan node of the merge join */
+  const AbstractPlanNode *GetRightPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Merge joins should have exactly two children plans.");
+    return GetChildAt(1);
+  }
+
+  /** @return the join key expressions evaluated on the left child */
+  const std::vector<const AbstractExpression *> &GetLeftKeys() const { return left_key_exprs_; }
+
+  /** @return the join key expressions evaluated on the right child */
+  const std::vector<const AbstractExpression *> &GetRightKeys() const { return right_key_exprs_; }
+
+ private:
+  std::vector<const AbstractExpression *> left_key_exprs_;
+  std::vector<const AbstractExpression *> right_key_exprs_;
+  /** The residual join predicate. */
+  const AbstractExpression *predicate_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_seq_scan_plan.h
+//
+// Identification: src/include/execution/plans/parallel_seq_scan_plan.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+/**
+ * ParallelSeqScanPlanNode scans a table like SeqScanPlanNode, splitting the pages among several worker threads.
+ * The tuples come out in no particular order.
+ */
+class ParallelSeqScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new parallel sequential scan plan node.
+   * @param output the output format of this scan plan node
+   * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) = true or predicate = nullptr
+   * @param table_oid the identifier of table to be scanned
+   * @param num_workers the number of workers, or 0 to use one per thread of the engine's pool
+   */
+  ParallelSeqScanPlanNode(const Schema *output, const AbstractExpression *predicate, table_oid_t table_oid,
+                          uint32_t num_workers = 0)
+      : AbstractPlanNode(output, {}), predicate_{predicate}, table_oid_(table_oid), num_workers_(num_workers) {}
+
+  PlanType GetType() const override { return PlanType::ParallelSeqScan; }
+
+  /** @return the predicate to test tuples against; tuples should only be returned if they evaluate to true */
+  const AbstractExpression *GetPredicate() const { return predicate_; }
+
+  /** @return the identifier of the table that should be scanned */
+  table_oid_t GetTableOid() const { return table_oid_; }
+
+  /** @return the number of workers, or 0 to use one per thread of the engine's pool */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
+ private:
+  /** The predicate that all returned tuples must satisfy. */
+  const AbstractExpression *predicate_;
+  /** The table whose tuples should be scanned. */
+  table_oid_t table_oid_;
+  /** The number of workers. */
+  uint32_t num_workers_;
+};
+
+}  // namespace bustub
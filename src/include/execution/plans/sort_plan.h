@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_plan.h
+//
+// Identification: src/include/execution/plans/sort_plan.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** OrderByType is the direction a sort key is ordered in. */
+enum class OrderByType { ASC, DESC };
+
+/** An ORDER BY clause entry: the direction and the expression to order by. */
+using OrderBy = std::pair<OrderByType, const AbstractExpression *>;
+
+/**
+ * Compares two sort keys. NULL orders before every other value, in either direction.
+ * @param order_bys the ORDER BY clause the keys were evaluated from
+ * @param lhs the values of the order by expressions for one tuple
+ * @param rhs the values of the order by expressions for the other tuple
+ * @return a negative number if lhs orders first, a positive number if rhs orders first, and 0 if they are tied
+ */
+inline int CompareSortKeys(const std::vector<OrderBy> &order_bys, const std::vector<Value> &lhs,
+                           const std::vector<Value> &rhs) {
+  for (uint32_t i = 0; i < order_bys.size(); i++) {
+    int cmp;
+    if (lhs[i].IsNull() || rhs[i].IsNull()) {
+      cmp = static_cast<int>(rhs[i].IsNull()) - static_cast<int>(lhs[i].IsNull());
+    } else if (lhs[i].CompareLessThan(rhs[i]) == CmpBool::CmpTrue) {
+      cmp = order_bys[i].first == OrderByType::ASC ? -1 : 1;
+    } else if (lhs[i].CompareGreaterThan(rhs[i]) == CmpBool::CmpTrue) {
+      cmp = order_bys[i].first == OrderByType::ASC ? 1 : -1;
+    } else {
+      cmp = 0;
+    }
+    if (cmp != 0) {
+      return cmp;
+    }
+  }
+  return 0;
+}
+
+/**
+ * SortPlanNode orders the tuples of its child by the ORDER BY clause. The tuples themselves are passed through
+ * unchanged, so the output schema is the child's.
+ */
+class SortPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new sort plan node.
+   * @param output_schema the output format of this plan node, the same as the child's
+   * @param child the child plan to sort the tuples of
+   * @param order_bys the keys to sort by, most significant first, evaluated against the child's output schema
+   */
+  SortPlanNode(const Schema *output_schema, const AbstractPlanNode *child, std::vector<OrderBy> &&order_bys)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)) {}
+
+  PlanType GetType() const override { return PlanType::Sort; }
+
+  /** @return the child plan of the sort */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Sort should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  /** @return the ORDER BY clause */
+  const std::vector<OrderBy> &GetOrderBys() const { return order_bys_; }
+
+ private:
+  std::vector<OrderBy> order_bys_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregate_plan.h
+//
+// Identification: src/include/execution/plans/streaming_aggregate_plan.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/plans/aggregation_plan.h"
+
+namespace bustub {
+
+/**
+ * StreamingAggregatePlanNode is an aggregation whose child produces the tuples of each group next to each other,
+ * e.g. an index scan ordered on the group by columns. Its groups come out in the order the child produces them.
+ */
+class StreamingAggregatePlanNode : public AggregationPlanNode {
+ public:
+  /**
+   * Creates a new StreamingAggregatePlanNode.
+   * @param output_schema the output format of this plan node
+   * @param child the child plan to aggregate data over, grouped on the group by expressions
+   * @param having the having clause of the aggregation
+   * @param group_bys the group by clause of the aggregation
+   * @param aggregates the expressions that we are aggregating
+   * @param agg_types the types that we are aggregating
+   */
+  StreamingAggregatePlanNode(const Schema *output_schema, const AbstractPlanNode *child,
+                             const AbstractExpression *having, std::vector<const AbstractExpression *> &&group_bys,
+                             std::vector<const AbstractExpression *> &&aggregates,
+                             std::vector<AggregationType> &&agg_types)
+      : AggregationPlanNode(output_schema, child, having, std::move(group_bys), std::move(aggregates),
+                            std::move(agg_types)) {}
+
+  PlanType GetType() const override { return PlanType::StreamingAggregate; }
+};
+
+}  // namespace bustub
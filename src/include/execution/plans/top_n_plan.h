@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_plan.h
+//
+// Identification: src/include/execution/plans/top_n_plan.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/sort_plan.h"
+
+namespace bustub {
+
+/**
+ * TopNPlanNode is ORDER BY ... LIMIT ... OFFSET ... in one node: it outputs the tuples of its child that would be
+ * at positions [offset, offset + limit) once sorted. The tuples are passed through unchanged.
+ */
+class TopNPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new top-n plan node.
+   * @param output_schema the output format of this plan node, the same as the child's
+   * @param child the child plan to take the top tuples of
+   * @param order_bys the keys to sort by, most significant first, evaluated against the child's output schema
+   * @param limit the number of output tuples
+   * @param offset the number of sorted tuples to be skipped
+   */
+  TopNPlanNode(const Schema *output_schema, const AbstractPlanNode *child, std::vector<OrderBy> order_bys,
+               size_t limit, size_t offset)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)), limit_(limit), offset_(offset) {}
+
+  PlanType GetType() const override { return PlanType::TopN; }
+
+  /** @return the child plan of the top-n */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "TopN should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  /** @return the ORDER BY clause */
+  const std::vector<OrderBy> &GetOrderBys() const { return order_bys_; }
+
+  size_t GetLimit() const { return limit_; }
+
+  size_t GetOffset() const { return offset_; }
+
+ private:
+  std::vector<OrderBy> order_bys_;
+  size_t limit_;
+  size_t offset_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/rid.h"
+#include "common/util/arena.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+/**
+ * TupleBatch is a group of tuples, with their rids, passed between executors in one NextBatch call so that the
+ * per-call overhead of the iterator model is paid once per batch instead of once per tuple.
+ *
+ * A batch has an arena for the memory of its tuples, which Clear frees. Executors build the tuples they output into
+ * it, so the tuples live exactly as long as the batch holds them, wherever the batch is moved to.
+ */
+class TupleBatch {
+ public:
+  /** Large enough to amortize a virtual call, small enough to stay cache resident. */
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Creates an empty batch.
+   * @param capacity the maximum number of tuples the batch holds
+   */
+  explicit TupleBatch(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity), arena_(std::make_unique<Arena>()) {
+    tuples_.reserve(capacity);
+    rids_.reserve(capacity);
+  }
+
+  /** Removes all the tuples from the batch, and frees the memory of its arena. */
+  void Clear() {
+    tuples_.clear();
+    rids_.clear();
+    if (arena_ == nullptr) {
+      // The batch was moved from.
+      arena_ = std::make_unique<Arena>();
+    } else {
+      arena_->Reset();
+    }
+  }
+
+  /**
+   * @return the arena of the batch, whose memory stays valid until the batch is cleared. A tuple that does not own its
+   * data may only be appended if its data is here
+   */
+  Arena *GetArena() { return arena_.get(); }
+
+  /** Adds a tuple to the end of the batch. */
+  void Append(const Tuple &tuple, RID rid) {
+    tuples_.push_back(tuple);
+    rids_.push_back(rid);
+  }
+
+  /** @return the number of tuples in the batch */
+  size_t Size() const { return tuples_.size(); }
+
+  /** @return the maximum number of tuples in the batch */
+  size_t Capacity() const { return capacity_; }
+
+  bool IsEmpty() const { return tuples_.empty(); }
+
+  bool IsFull() const { return tuples_.size() >= capacity_; }
+
+  /** @return the tuple at the given position of the batch */
+  const Tuple &GetTuple(size_t idx) const { return tuples_[idx]; }
+
+  /** @return the rid of the tuple at the given position of the batch */
+  RID GetRid(size_t idx) const { return rids_[idx]; }
+
+ private:
+  size_t capacity_;
+  std::vector<Tuple> tuples_;
+  std::vector<RID> rids_;
+  /** Behind a pointer, so that moving the batch does not move the memory its tuples point to. */
+  std::unique_ptr<Arena> arena_;
+};
+}  // namespace bustub
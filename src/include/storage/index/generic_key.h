@@ -15,6 +15,7 @@
 #include <cstring>
 
 #include "storage/table/tuple.h"
+#include "type/type_dispatch.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -80,6 +81,18 @@ class GenericComparator {
     uint32_t column_count = key_schema_->GetColumnCount();
 
     for (uint32_t i = 0; i < column_count; i++) {
+      // Fixed-size columns are compared in place, without building Values or calling into their Type.
+      const auto &col = key_schema_->GetColumn(i);
+      int cmp = 0;
+      const char *lhs_data = lhs.data_ + col.GetOffset();
+      const char *rhs_data = rhs.data_ + col.GetOffset();
+      if (col.IsInlined() && TypeDispatch::CompareSerialized(col.GetType(), lhs_data, rhs_data, &cmp)) {
+        if (cmp != 0) {
+          return cmp;
+        }
+        continue;
+      }
+
       Value lhs_value = (lhs.ToValue(key_schema_, i));
       Value rhs_value = (rhs.ToValue(key_schema_, i));
 
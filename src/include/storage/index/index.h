@@ -102,12 +102,14 @@ class IndexMetadata {
  */
 class Index {
  public:
-  explicit Index(IndexMetadata *metadata) : metadata_(metadata) {}
+  // The index owns its metadata from the moment the Index base is constructed, so a derived constructor that
+  // throws afterwards still frees it
+  explicit Index(std::unique_ptr<IndexMetadata> metadata) : metadata_(std::move(metadata)) {}
 
-  virtual ~Index() { delete metadata_; }
+  virtual ~Index() = default;
 
   // Return the metadata object associated with the index
-  IndexMetadata *GetMetadata() const { return metadata_; }
+  IndexMetadata *GetMetadata() const { return metadata_.get(); }
 
   int GetIndexColumnCount() const { return metadata_->GetIndexColumnCount(); }
 
@@ -137,11 +139,21 @@ class Index {
 
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  // point query for a batch of keys, results[i] receives the matches of keys[i]. Indexes that can share work
+  // across lookups (e.g. page fetches) override this; the default runs ScanKey per key.
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                        Transaction *transaction) {
+    results->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*results)[i], transaction);
+    }
+  }
+
  private:
   //===--------------------------------------------------------------------===//
   //  Data members
   //===--------------------------------------------------------------------===//
-  IndexMetadata *metadata_;
+  std::unique_ptr<IndexMetadata> metadata_;
 };
 
 }  // namespace bustub
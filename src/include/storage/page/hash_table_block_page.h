@@ -12,7 +12,7 @@
 
 #pragma once
 
-#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -32,6 +32,23 @@ namespace bustub {
  *
  *  Here '+' means concatenation.
  *
+ * The pairs are preceded by one control byte per slot (Swiss table style):
+ *  - 0x00: empty, never occupied. Pages come zeroed from the buffer pool.
+ *  - 0x01: tombstone, occupied but no longer readable.
+ *  - 0x80 | fingerprint: readable, with the low 7 bits holding a fingerprint of the key's hash.
+ *
+ * Slots are probed BLOCK_GROUP_SIZE at a time: one SIMD compare over a group's
+ * control bytes yields every slot whose fingerprint matches, so keys are only
+ * read for likely hits and a probe touches the control line plus the matching
+ * pair instead of two bitmaps plus every pair. The block page itself is not
+ * thread safe; callers hold the page latch.
+ *
+ * This layout replaced the previous one rather than being offered next to it.
+ * That layout kept occupied_ and readable_ bitmaps, one bit per slot, ahead of
+ * the pairs. The two are not compatible on disk: BLOCK_ARRAY_SIZE, the offset
+ * of the pairs and the meaning of the bytes ahead of them all changed. A block
+ * page written with the bitmap layout cannot be read with this one, so a linear
+ * probe hash table persisted before the change has to be rebuilt.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class HashTableBlockPage {
@@ -57,18 +74,15 @@ class HashTableBlockPage {
 
   /**
    * Attempts to insert a key and value into an index in the block.
-   * The insert is thread safe. It uses compare and swap to claim the index,
-   * and then writes the key and value into the index, and then marks the
-   * index as readable.
    *
    * @param bucket_ind index to write the key and value to
    * @param key key to insert
    * @param value value to insert
+   * @param fingerprint the key's 7-bit hash fingerprint, see FingerprintOf
    * @return If the value is inserted successfully, it returns true. If the
-   * index is marked as occupied before the key and value can be inserted,
-   * Insert returns false.
+   * index is already occupied, Insert returns false.
    */
-  bool Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value);
+  bool Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value, uint8_t fingerprint);
 
   /**
    * Removes a key and value at index.
@@ -93,11 +107,41 @@ class HashTableBlockPage {
    */
   bool IsReadable(slot_offset_t bucket_ind) const;
 
+  /**
+   * Finds the readable slots of a group whose fingerprint matches.
+   *
+   * @param group_ind index of the first slot of the group, a multiple of BLOCK_GROUP_SIZE
+   * @param fingerprint the fingerprint to look for
+   * @return a bitmask with bit i set if slot group_ind + i may hold the key
+   */
+  uint32_t MatchFingerprint(slot_offset_t group_ind, uint8_t fingerprint) const;
+
+  /**
+   * Finds the never-occupied slots of a group. A probe sequence ends at the
+   * first group that has one.
+   *
+   * @param group_ind index of the first slot of the group, a multiple of BLOCK_GROUP_SIZE
+   * @return a bitmask with bit i set if slot group_ind + i is empty
+   */
+  uint32_t MatchEmpty(slot_offset_t group_ind) const;
+
+  /**
+   * @param hash a 64-bit hash of the key
+   * @return the 7-bit fingerprint stored in the key's control byte, taken from
+   * the high bits so that it is independent of the low bits used to pick a slot
+   */
+  static uint8_t FingerprintOf(uint64_t hash) { return static_cast<uint8_t>(hash >> 57); }
+
  private:
-  std::atomic_char occupied_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
+  static constexpr uint8_t CTRL_EMPTY = 0x00;
+  static constexpr uint8_t CTRL_TOMBSTONE = 0x01;
+  static constexpr uint8_t CTRL_READABLE = 0x80;
+
+  /** Returns a bitmask of the slots in the group whose control byte equals ctrl. */
+  uint32_t MatchControl(slot_offset_t group_ind, uint8_t ctrl) const;
 
-  // 0 if tombstone/brand new (never occupied), 1 otherwise.
-  std::atomic_char readable_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
+  // BLOCK_ARRAY_SIZE is a multiple of BLOCK_GROUP_SIZE, so array_ stays 16-byte aligned.
+  uint8_t ctrl_[BLOCK_ARRAY_SIZE];
   MappingType array_[0];
 };
 
@@ -0,0 +1,184 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_table_directory_page.h
+//
+// Identification: src/include/storage/page/hash_table_directory_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+#include "storage/page/hash_table_page_defs.h"
+
+namespace bustub {
+
+/**
+ *
+ * Directory Page for extendible hash table.
+ *
+ * Directory format (size in byte):
+ * --------------------------------------------------------------------------------------------
+ * | PageId(4) | LSN (4) | GlobalDepth(4) | LocalDepths(512) | BucketPageIds(2048) | Free(1524)
+ * --------------------------------------------------------------------------------------------
+ */
+class HashTableDirectoryPage {
+ public:
+  /**
+   * @return the page ID of this page
+   */
+  page_id_t GetPageId() const;
+
+  /**
+   * Sets the page ID of this page
+   *
+   * @param page_id the page id to which to set the page_id_ field
+   */
+  void SetPageId(page_id_t page_id);
+
+  /**
+   * @return the lsn of this page
+   */
+  lsn_t GetLSN() const;
+
+  /**
+   * Sets the LSN of this page
+   *
+   * @param lsn the log sequence number to which to set the lsn field
+   */
+  void SetLSN(lsn_t lsn);
+
+  /**
+   * Lookup a bucket page using a directory index
+   *
+   * @param bucket_idx the index in the directory to lookup
+   * @return bucket page_id corresponding to bucket_idx
+   */
+  page_id_t GetBucketPageId(uint32_t bucket_idx) const;
+
+  /**
+   * Updates the directory index using a bucket index and page_id
+   *
+   * @param bucket_idx directory index at which to insert page_id
+   * @param bucket_page_id page_id to insert
+   */
+  void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id);
+
+  /**
+   * Gets the split image of an index, i.e. the directory index that shared the bucket before the last split at the
+   * bucket's local depth.
+   *
+   * @param bucket_idx the directory index for which to find the split image
+   * @return the directory index of the split image
+   **/
+  uint32_t GetSplitImageIndex(uint32_t bucket_idx) const;
+
+  /**
+   * @return a mask of global_depth 1's and the rest 0's (with 1's from the LSB upwards)
+   */
+  uint32_t GetGlobalDepthMask() const;
+
+  /**
+   * @param bucket_idx the index to use for looking up local depth
+   * @return a mask of local_depth 1's and the rest 0's (with 1's from the LSB upwards)
+   */
+  uint32_t GetLocalDepthMask(uint32_t bucket_idx) const;
+
+  /**
+   * @return the global depth of the hash table directory
+   */
+  uint32_t GetGlobalDepth() const;
+
+  /**
+   * Increments the global depth of the directory. The new upper half of the directory mirrors the lower half, so every
+   * bucket is now referenced by twice as many slots.
+   */
+  void IncrGlobalDepth();
+
+  /**
+   * Decrements the global depth of the directory
+   */
+  void DecrGlobalDepth();
+
+  /**
+   * @return true if the directory can be shrunk, i.e. every local depth is less than the global depth
+   */
+  bool CanShrink() const;
+
+  /**
+   * @return the current directory size
+   */
+  uint32_t Size() const;
+
+  /**
+   * @return the maximum number of slots the directory can ever hold
+   */
+  static constexpr uint32_t MaxSize() { return DIRECTORY_ARRAY_SIZE; }
+
+  /**
+   * Gets the local depth of the bucket at bucket_idx
+   *
+   * @param bucket_idx the bucket index to lookup
+   * @return the local depth of the bucket at bucket_idx
+   */
+  uint32_t GetLocalDepth(uint32_t bucket_idx) const;
+
+  /**
+   * Set the local depth of the bucket at bucket_idx to local_depth
+   *
+   * @param bucket_idx bucket index to update
+   * @param local_depth new local depth
+   */
+  void SetLocalDepth(uint32_t bucket_idx, uint8_t local_depth);
+
+  /**
+   * Increment the local depth of the bucket at bucket_idx
+   * @param bucket_idx bucket index to increment
+   */
+  void IncrLocalDepth(uint32_t bucket_idx);
+
+  /**
+   * Decrement the local depth of the bucket at bucket_idx
+   * @param bucket_idx bucket index to decrement
+   */
+  void DecrLocalDepth(uint32_t bucket_idx);
+
+  /**
+   * Gets the high bit corresponding to the bucket's local depth, i.e. the bit that distinguishes a bucket from the
+   * bucket it would split into.
+   *
+   * @param bucket_idx bucket index to lookup
+   * @return the high bit corresponding to the bucket's local depth
+   */
+  uint32_t GetLocalHighBit(uint32_t bucket_idx) const;
+
+  /**
+   * Verify the following invariants:
+   * (1) All LD <= GD.
+   * (2) Each bucket has precisely 2^(GD - LD) pointers pointing to it.
+   * (3) The LD is the same at each index with the same bucket_page_id
+   */
+  void VerifyIntegrity() const;
+
+  /**
+   * Prints the current directory
+   */
+  void PrintDirectory() const;
+
+ private:
+  page_id_t page_id_;
+  lsn_t lsn_;
+  uint32_t global_depth_{0};
+  uint8_t local_depths_[DIRECTORY_ARRAY_SIZE];
+  page_id_t bucket_page_ids_[DIRECTORY_ARRAY_SIZE];
+};
+
+static_assert(sizeof(HashTableDirectoryPage) <= PAGE_SIZE, "directory page must fit in a page");
+
+}  // namespace bustub
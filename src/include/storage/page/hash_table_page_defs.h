@@ -14,11 +14,23 @@
 
 #define MappingType std::pair<KeyType, ValueType>
 
-/** BLOCK_ARRAY_SIZE is the number of (key, value) pairs that can be stored in   * a block page. It is an approximate
- * calculation based on the size of MappingType (which is a std::pair of KeyType and ValueType). For each key/value
- * pair, we need two additional bits for occupied_ and readable_. 4 * PAGE_SIZE / (4 * sizeof (MappingType) + 1) =
- * PAGE_SIZE/(sizeof (MappingType) + 0.25) because 0.25 bytes = 2 bits is the space required to maintain the occupied
- * and readable flags for a key value pair.*/
-#define BLOCK_ARRAY_SIZE (4 * PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+/** BLOCK_GROUP_SIZE is the number of slots whose control bytes are probed together, i.e. one SSE2 register. */
+#define BLOCK_GROUP_SIZE 16
+
+/** BLOCK_ARRAY_SIZE is the number of (key, value) pairs that can be stored in a block page. Each pair needs one extra
+ * control byte, so a page holds PAGE_SIZE / (sizeof (MappingType) + 1) pairs, rounded down to a whole number of
+ * BLOCK_GROUP_SIZE groups so that probes never straddle a group that is only partly in the page. */
+#define BLOCK_ARRAY_SIZE (PAGE_SIZE / (sizeof(MappingType) + 1) / BLOCK_GROUP_SIZE * BLOCK_GROUP_SIZE)
 
 #define HASH_TABLE_BLOCK_TYPE HashTableBlockPage<KeyType, ValueType, KeyComparator>
+
+/** BUCKET_ARRAY_SIZE is the number of (key, value) pairs that fit in an extendible hash table bucket page. For each
+ * pair, two additional bits are needed for the occupied_ and readable_ bitmaps, so 4 * PAGE_SIZE /
+ * (4 * sizeof (MappingType) + 1) = PAGE_SIZE / (sizeof (MappingType) + 0.25). */
+#define BUCKET_ARRAY_SIZE (4 * PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+
+/** DIRECTORY_ARRAY_SIZE is the maximum number of slots in an extendible hash table directory page, i.e. the directory
+ * can grow up to a global depth of 9. */
+#define DIRECTORY_ARRAY_SIZE 512
+
+#define HASH_TABLE_BUCKET_TYPE HashTableBucketPage<KeyType, ValueType, KeyComparator>
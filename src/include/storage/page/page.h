@@ -39,6 +39,9 @@ class Page {
   /** @return the actual data contained within this page */
   inline char *GetData() { return data_; }
 
+  /** @return the actual data contained within this page, for reading */
+  inline const char *GetData() const { return data_; }
+
   /** @return the page id of this page */
   inline page_id_t GetPageId() { return page_id_; }
 
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_guard.h
+//
+// Identification: src/include/storage/page/page_guard.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <type_traits>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/page/page.h"
+
+namespace bustub {
+
+/**
+ * PageGuard holds the pin of a buffer pool page and unpins it when it is dropped or destroyed, reporting how long the
+ * page was pinned to the buffer pool manager. It can be moved but not copied, so the page is unpinned exactly once.
+ * ReadPageGuard and WritePageGuard wrap one to also hold the page's latch.
+ */
+class PageGuard {
+ public:
+  /** Creates an empty guard. */
+  PageGuard() = default;
+
+  /**
+   * Takes over the pin of a fetched page.
+   * @param bpm the buffer pool manager the page was fetched from
+   * @param page the pinned page, or nullptr for an empty guard
+   */
+  PageGuard(BufferPoolManager *bpm, Page *page);
+
+  PageGuard(const PageGuard &) = delete;
+  PageGuard &operator=(const PageGuard &) = delete;
+
+  PageGuard(PageGuard &&other) noexcept;
+  PageGuard &operator=(PageGuard &&other) noexcept;
+
+  ~PageGuard() { Drop(); }
+
+  /** Unpins the page, if the guard holds one. */
+  void Drop();
+
+  /** @return true if the guard holds a page */
+  bool IsValid() const { return page_ != nullptr; }
+
+  /** @return the id of the guarded page */
+  page_id_t PageId() const { return page_->GetPageId(); }
+
+  /** @return the guarded page, or nullptr */
+  Page *GetPage() const { return page_; }
+
+  /** @return the data of the guarded page */
+  const char *GetData() const { return page_->GetData(); }
+
+  /**
+   * @return the guarded page as a T. A subclass of Page such as TablePage is cast from the page itself; any other
+   * type, such as a HashTableBucketPage, is laid over the page data.
+   */
+  template <typename T>
+  T *As() const {
+    if constexpr (std::is_base_of_v<Page, T>) {
+      return reinterpret_cast<T *>(page_);
+    } else {
+      return reinterpret_cast<T *>(page_->GetData());
+    }
+  }
+
+  /** Marks the page dirty, so that it is written back before it is evicted. */
+  void MarkDirty() { is_dirty_ = true; }
+
+ private:
+  BufferPoolManager *bpm_{nullptr};
+  Page *page_{nullptr};
+  bool is_dirty_{false};
+  /** When the guard took over the pin. */
+  std::chrono::steady_clock::time_point pinned_at_;
+};
+
+/**
+ * ReadPageGuard holds the pin and the read latch of a page, and only gives read access to it. It holds a PageGuard
+ * rather than being one, so it cannot be converted into a guard that would unpin the page without unlatching it.
+ */
+class ReadPageGuard {
+ public:
+  /** Creates an empty guard. */
+  ReadPageGuard() = default;
+
+  /**
+   * Takes over the pin of a fetched page and read latches it.
+   * @param bpm the buffer pool manager the page was fetched from
+   * @param page the pinned page, or nullptr for an empty guard
+   */
+  ReadPageGuard(BufferPoolManager *bpm, Page *page);
+
+  ReadPageGuard(ReadPageGuard &&other) noexcept = default;
+  ReadPageGuard &operator=(ReadPageGuard &&other) noexcept;
+
+  ~ReadPageGuard() { Drop(); }
+
+  /** Unlatches and unpins the page, if the guard holds one. */
+  void Drop();
+
+  /** @return true if the guard holds a page */
+  bool IsValid() const { return guard_.IsValid(); }
+
+  /** @return the id of the guarded page */
+  page_id_t PageId() const { return guard_.PageId(); }
+
+  /** @return the data of the guarded page */
+  const char *GetData() const { return guard_.GetData(); }
+
+  /** @return the guarded page as a T, see PageGuard::As */
+  template <typename T>
+  const T *As() const {
+    return guard_.As<T>();
+  }
+
+ private:
+  PageGuard guard_;
+};
+
+/**
+ * WritePageGuard holds the pin and the write latch of a page. Changes to the page must mark it dirty. Like
+ * ReadPageGuard, it holds a PageGuard rather than being one.
+ */
+class WritePageGuard {
+ public:
+  /** Creates an empty guard. */
+  WritePageGuard() = default;
+
+  /**
+   * Takes over the pin of a fetched page and write latches it.
+   * @param bpm the buffer pool manager the page was fetched from
+   * @param page the pinned page, or nullptr for an empty guard
+   */
+  WritePageGuard(BufferPoolManager *bpm, Page *page);
+
+  WritePageGuard(WritePageGuard &&other) noexcept = default;
+  WritePageGuard &operator=(WritePageGuard &&other) noexcept;
+
+  ~WritePageGuard() { Drop(); }
+
+  /** Unlatches and unpins the page, if the guard holds one. */
+  void Drop();
+
+  /** @return true if the guard holds a page */
+  bool IsValid() const { return guard_.IsValid(); }
+
+  /** @return the id of the guarded page */
+  page_id_t PageId() const { return guard_.PageId(); }
+
+  /** @return the data of the guarded page */
+  const char *GetData() const { return guard_.GetData(); }
+
+  /** @return the data of the guarded page, for writing */
+  char *GetDataMut() {
+    guard_.MarkDirty();
+    return guard_.GetPage()->GetData();
+  }
+
+  /** @return the guarded page as a T, see PageGuard::As. Changes made through it must mark the page dirty. */
+  template <typename T>
+  T *As() const {
+    return guard_.As<T>();
+  }
+
+  /** Marks the page dirty, so that it is written back before it is evicted. */
+  void MarkDirty() { guard_.MarkDirty(); }
+
+ private:
+  PageGuard guard_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_range_dispenser.h
+//
+// Identification: src/include/storage/table/page_range_dispenser.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * PageRangeDispenser hands out the pages of a table heap to the workers of a parallel scan, each page exactly once.
+ *
+ * Every worker has a queue of pages it owns. When its queue runs dry, a worker claims the next range of pages from
+ * the heap's linked list, which only one worker walks at a time. Once the list is exhausted, an idle worker steals
+ * half of the pages left in the fullest queue, so that a worker slowed down by skew does not hold up the scan.
+ */
+class PageRangeDispenser {
+ public:
+  /** Large enough to keep contention on the list low, small enough to leave work to steal. */
+  static constexpr uint32_t DEFAULT_RANGE_SIZE = 16;
+
+  /**
+   * Creates a dispenser over a table heap.
+   * @param bpm the buffer pool manager holding the heap's pages
+   * @param first_page_id the first page of the heap
+   * @param num_workers the number of workers that will ask for pages
+   * @param range_size the number of pages a worker claims from the list at a time
+   */
+  PageRangeDispenser(BufferPoolManager *bpm, page_id_t first_page_id, uint32_t num_workers,
+                     uint32_t range_size = DEFAULT_RANGE_SIZE);
+
+  DISALLOW_COPY_AND_MOVE(PageRangeDispenser);
+
+  /**
+   * @param worker_id the worker asking, in [0, num_workers)
+   * @return the next page for the worker to scan, or INVALID_PAGE_ID once every page has been handed out
+   */
+  page_id_t Next(uint32_t worker_id);
+
+ private:
+  /** The pages a worker owns and has not scanned yet. The owner takes from the front, thieves from the back. */
+  struct WorkerQueue {
+    std::mutex latch_;
+    std::deque<page_id_t> pages_;
+  };
+
+  /**
+   * Walks the next range of the linked list into the worker's queue.
+   * @return false if the list is exhausted
+   */
+  bool ClaimRange(uint32_t worker_id);
+
+  /**
+   * Moves half of the pages of the fullest other queue into the worker's queue.
+   * @return false if every other queue is empty
+   */
+  bool Steal(uint32_t worker_id);
+
+  BufferPoolManager *bpm_;
+  uint32_t range_size_;
+  std::vector<WorkerQueue> queues_;
+  /** Protects next_page_id_, the first page of the list not claimed yet. */
+  std::mutex list_latch_;
+  page_id_t next_page_id_;
+};
+
+}  // namespace bustub
@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 namespace bustub {
 
@@ -99,6 +102,15 @@ class TableHeap {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
 
+  /**
+   * Read a tuple from the table without copying it.
+   * @param rid rid of the tuple to read
+   * @param[out] view a view of the tuple, which keeps its page pinned and read latched
+   * @param txn transaction performing the read
+   * @return true if the read was successful (i.e. the tuple exists)
+   */
+  bool GetTupleView(const RID &rid, TupleView *view, Transaction *txn);
+
   /** @return the begin iterator of this table */
   TableIterator Begin(Transaction *txn);
 
@@ -108,11 +120,18 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * @return the number of tuples inserted through this heap and not deleted since, for estimating the size of scans;
+   * tuples that were already in an opened table are not counted
+   */
+  size_t GetApproxNumTuples() const { return num_tuples_.load(std::memory_order_relaxed); }
+
  private:
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  std::atomic<size_t> num_tuples_{0};
 };
 
 }  // namespace bustub
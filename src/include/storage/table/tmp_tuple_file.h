@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is an append-only sequence of TmpTuplePages in the buffer pool that executors spill intermediate
+ * tuples into. Only the page being appended to stays pinned. The pages are deleted with the file.
+ */
+class TmpTupleFile {
+ public:
+  /**
+   * Creates an empty file.
+   * @param bpm the buffer pool manager the pages are allocated from
+   */
+  explicit TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  ~TmpTupleFile();
+
+  /**
+   * Appends a tuple to the end of the file.
+   * @param tuple the tuple to append
+   * @param[out] out the location of the appended tuple, if not nullptr
+   */
+  void Append(const Tuple &tuple, TmpTuple *out = nullptr);
+
+  /** Unpins the page being appended to. Appending after Finish pins it again. */
+  void Finish();
+
+  /** @return the number of tuples in the file */
+  size_t GetNumTuples() const { return num_tuples_; }
+
+  /** @return the total serialized size of the tuples in the file */
+  size_t GetNumBytes() const { return num_bytes_; }
+
+  /**
+   * Reader scans the tuples of a file in the order they were appended, keeping one page pinned at a time.
+   */
+  class Reader {
+   public:
+    explicit Reader(const TmpTupleFile *file) : file_(file) {}
+
+    DISALLOW_COPY_AND_MOVE(Reader);
+
+    ~Reader();
+
+    /**
+     * Reads the next tuple of the file.
+     * @param[out] tuple the next tuple
+     * @return false if there are no more tuples
+     */
+    bool Next(Tuple *tuple);
+
+   private:
+    const TmpTupleFile *file_;
+    /** The index into the file's pages of the next page to read. */
+    size_t next_page_idx_{0};
+    /** The pinned page being read, or nullptr. */
+    TmpTuplePage *page_{nullptr};
+    /** The offsets of the unread tuples on page_, the next one last. */
+    std::vector<uint32_t> offsets_;
+  };
+
+  /** @return a reader positioned at the first tuple of the file */
+  std::unique_ptr<Reader> MakeReader() const { return std::make_unique<Reader>(this); }
+
+ private:
+  BufferPoolManager *bpm_;
+  std::vector<page_id_t> page_ids_;
+  /** The last page of the file if it is pinned for appending, or nullptr. */
+  TmpTuplePage *tail_{nullptr};
+  size_t num_tuples_{0};
+  size_t num_bytes_{0};
+};
+
+}  // namespace bustub
@@ -17,6 +17,7 @@
 
 #include "catalog/schema.h"
 #include "common/rid.h"
+#include "common/util/arena.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -44,12 +45,25 @@ class Tuple {
   // constructor for creating a new tuple based on input value
   Tuple(std::vector<Value> values, const Schema *schema);
 
+  // constructor for creating a new tuple based on input value, in memory from the arena. The tuple does not own its
+  // data, so it and its (shallow) copies are valid as long as the arena's memory is
+  Tuple(const std::vector<Value> &values, const Schema *schema, Arena *arena);
+
   // copy constructor, deep copy
   Tuple(const Tuple &other);
 
+  // copy constructor, deep copy into memory from the arena. The copy does not own its data
+  Tuple(const Tuple &other, Arena *arena);
+
+  // move constructor, takes over other's data and leaves other empty
+  Tuple(Tuple &&other) noexcept;
+
   // assign operator, deep copy
   Tuple &operator=(const Tuple &other);
 
+  // move assign operator, takes over other's data and leaves other empty
+  Tuple &operator=(Tuple &&other) noexcept;
+
   ~Tuple() {
     if (allocated_) {
       delete[] data_;
@@ -63,6 +77,9 @@ class Tuple {
   // deserialize tuple data(deep copy)
   void DeserializeFrom(const char *storage);
 
+  // return a deep copy that owns its data, even if this tuple does not
+  Tuple Materialize() const;
+
   // return RID of current tuple
   inline RID GetRid() const { return rid_; }
 
@@ -84,7 +101,7 @@ class Tuple {
     Value value = GetValue(schema, column_idx);
     return value.IsNull();
   }
-  inline bool IsAllocated() { return allocated_; }
+  inline bool IsAllocated() const { return allocated_; }
 
   std::string ToString(const Schema *schema) const;
 
@@ -92,6 +109,12 @@ class Tuple {
   // Get the starting storage address of specific column
   const char *GetDataPtr(const Schema *schema, uint32_t column_idx) const;
 
+  // Get the size of a tuple of the given values
+  static uint32_t SerializedSize(const std::vector<Value> &values, const Schema *schema);
+
+  // Serialize the given values into data_, which holds size_ bytes
+  void SerializeValues(const std::vector<Value> &values, const Schema *schema);
+
   bool allocated_{false};  // is allocated?
   RID rid_{};              // if pointing to the table heap, the rid is valid
   uint32_t size_{0};
@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.h
+//
+// Identification: src/include/storage/table/tuple_view.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "storage/page/page_guard.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TupleView reads a table tuple in place, from the bytes of its buffer pool page, instead of copying it into a Tuple
+ * of its own. The view shares a guard on the page with the other views of the page, so the page stays pinned and
+ * read latched until the last of them is gone. GetTuple is an unallocated Tuple over the page bytes, which
+ * expressions evaluate like any other tuple.
+ *
+ * A view holds its page's read latch, so it should be dropped before the executor returns to its parent, and
+ * anything that outlives it should be projected or materialized from it first.
+ */
+class TupleView {
+ public:
+  /** Creates an empty view. */
+  TupleView() = default;
+
+  /**
+   * Creates a view of a tuple.
+   * @param page the guard on the tuple's page
+   * @param tuple an unallocated tuple over the bytes of the page, e.g. from TablePage::GetTupleInPlace
+   */
+  TupleView(std::shared_ptr<const ReadPageGuard> page, const Tuple &tuple) : page_(std::move(page)), tuple_(tuple) {}
+
+  /** @return true if the view holds a tuple */
+  bool IsValid() const { return page_ != nullptr; }
+
+  /** @return the tuple, valid as long as the view */
+  const Tuple &GetTuple() const { return tuple_; }
+
+  /** @return the RID of the tuple */
+  RID GetRid() const { return tuple_.GetRid(); }
+
+  /** @return the value of a column of the tuple */
+  Value GetValue(const Schema *schema, uint32_t column_idx) const { return tuple_.GetValue(schema, column_idx); }
+
+  /** @return a copy of the tuple that owns its bytes and outlives the view */
+  Tuple Materialize() const { return tuple_.Materialize(); }
+
+  /** Releases the view's share of the page guard. */
+  void Reset() {
+    page_.reset();
+    tuple_ = Tuple();
+  }
+
+ private:
+  std::shared_ptr<const ReadPageGuard> page_;
+  Tuple tuple_;
+};
+
+}  // namespace bustub
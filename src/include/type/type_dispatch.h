@@ -0,0 +1,243 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// type_dispatch.h
+//
+// Identification: src/include/type/type_dispatch.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "common/exception.h"
+#include "type/limits.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** NativeType maps a fixed-size type to the C++ type its values hold, and to the value that stands for NULL. */
+template <TypeId ID>
+struct NativeType;
+
+template <>
+struct NativeType<TypeId::BOOLEAN> {
+  using T = int8_t;
+  static constexpr T NULL_VALUE = BUSTUB_BOOLEAN_NULL;
+};
+
+template <>
+struct NativeType<TypeId::TINYINT> {
+  using T = int8_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT8_NULL;
+};
+
+template <>
+struct NativeType<TypeId::SMALLINT> {
+  using T = int16_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT16_NULL;
+};
+
+template <>
+struct NativeType<TypeId::INTEGER> {
+  using T = int32_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT32_NULL;
+};
+
+template <>
+struct NativeType<TypeId::BIGINT> {
+  using T = int64_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT64_NULL;
+};
+
+template <>
+struct NativeType<TypeId::DECIMAL> {
+  using T = double;
+  static constexpr T NULL_VALUE = BUSTUB_DECIMAL_NULL;
+};
+
+template <>
+struct NativeType<TypeId::TIMESTAMP> {
+  using T = uint64_t;
+  static constexpr T NULL_VALUE = BUSTUB_TIMESTAMP_NULL;
+};
+
+/** TypeTag carries a type known at compile time into the kernels of TypeSwitch. */
+template <TypeId ID>
+using TypeTag = std::integral_constant<TypeId, ID>;
+
+/**
+ * Switches on a type once and calls kernel(TypeTag<type_id>{}), so a generic lambda is instantiated into one
+ * monomorphic kernel per type, with no virtual calls inside. Only the fixed-size types are switched on.
+ * @return true if the kernel was called, false for the other types
+ */
+template <typename Kernel>
+inline bool TypeSwitch(TypeId type_id, Kernel &&kernel) {
+  switch (type_id) {
+    case TypeId::BOOLEAN:
+      kernel(TypeTag<TypeId::BOOLEAN>{});
+      return true;
+    case TypeId::TINYINT:
+      kernel(TypeTag<TypeId::TINYINT>{});
+      return true;
+    case TypeId::SMALLINT:
+      kernel(TypeTag<TypeId::SMALLINT>{});
+      return true;
+    case TypeId::INTEGER:
+      kernel(TypeTag<TypeId::INTEGER>{});
+      return true;
+    case TypeId::BIGINT:
+      kernel(TypeTag<TypeId::BIGINT>{});
+      return true;
+    case TypeId::DECIMAL:
+      kernel(TypeTag<TypeId::DECIMAL>{});
+      return true;
+    case TypeId::TIMESTAMP:
+      kernel(TypeTag<TypeId::TIMESTAMP>{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Like TypeSwitch, but only for the integer types, so the kernel is only instantiated for them. */
+template <typename Kernel>
+inline bool IntegerTypeSwitch(TypeId type_id, Kernel &&kernel) {
+  switch (type_id) {
+    case TypeId::TINYINT:
+      kernel(TypeTag<TypeId::TINYINT>{});
+      return true;
+    case TypeId::SMALLINT:
+      kernel(TypeTag<TypeId::SMALLINT>{});
+      return true;
+    case TypeId::INTEGER:
+      kernel(TypeTag<TypeId::INTEGER>{});
+      return true;
+    case TypeId::BIGINT:
+      kernel(TypeTag<TypeId::BIGINT>{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * TypeDispatch has the Value operations of the hot paths of execution. Two non-NULL values of the same fixed-size
+ * type are handled by a kernel picked with TypeSwitch; anything else (NULLs, VARCHARs, mixed types) goes through the
+ * virtual Type of the left value, as Value does. Either way the results are the same as Value's.
+ */
+class TypeDispatch {
+ public:
+  static CmpBool CompareEquals(const Value &lhs, const Value &rhs) {
+    return Compare<std::equal_to<>>(lhs, rhs, &Value::CompareEquals);
+  }
+  static CmpBool CompareNotEquals(const Value &lhs, const Value &rhs) {
+    return Compare<std::not_equal_to<>>(lhs, rhs, &Value::CompareNotEquals);
+  }
+  static CmpBool CompareLessThan(const Value &lhs, const Value &rhs) {
+    return Compare<std::less<>>(lhs, rhs, &Value::CompareLessThan);
+  }
+  static CmpBool CompareLessThanEquals(const Value &lhs, const Value &rhs) {
+    return Compare<std::less_equal<>>(lhs, rhs, &Value::CompareLessThanEquals);
+  }
+  static CmpBool CompareGreaterThan(const Value &lhs, const Value &rhs) {
+    return Compare<std::greater<>>(lhs, rhs, &Value::CompareGreaterThan);
+  }
+  static CmpBool CompareGreaterThanEquals(const Value &lhs, const Value &rhs) {
+    return Compare<std::greater_equal<>>(lhs, rhs, &Value::CompareGreaterThanEquals);
+  }
+
+  /** @return lhs + rhs; throws OUT_OF_RANGE if the sum of two integers overflows */
+  static Value Add(const Value &lhs, const Value &rhs) {
+    Value result;
+    if (IsSameNonNull(lhs, rhs) && IntegerTypeSwitch(lhs.GetTypeId(), [&](auto tag) {
+          using T = typename NativeType<decltype(tag)::value>::T;
+          T sum;
+          if (__builtin_add_overflow(lhs.GetAs<T>(), rhs.GetAs<T>(), &sum)) {
+            throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+          }
+          result = Value(decltype(tag)::value, sum);
+        })) {
+      return result;
+    }
+    return lhs.Add(rhs);
+  }
+
+  /** @return the smaller of lhs and rhs */
+  static Value Min(const Value &lhs, const Value &rhs) {
+    bool is_lhs = false;
+    if (IsSameNonNull(lhs, rhs) && IntegerTypeSwitch(lhs.GetTypeId(), [&](auto tag) {
+          using T = typename NativeType<decltype(tag)::value>::T;
+          is_lhs = lhs.GetAs<T>() < rhs.GetAs<T>();
+        })) {
+      return is_lhs ? lhs : rhs;
+    }
+    return lhs.Min(rhs);
+  }
+
+  /** @return the larger of lhs and rhs */
+  static Value Max(const Value &lhs, const Value &rhs) {
+    bool is_lhs = false;
+    if (IsSameNonNull(lhs, rhs) && IntegerTypeSwitch(lhs.GetTypeId(), [&](auto tag) {
+          using T = typename NativeType<decltype(tag)::value>::T;
+          is_lhs = lhs.GetAs<T>() >= rhs.GetAs<T>();
+        })) {
+      return is_lhs ? lhs : rhs;
+    }
+    return lhs.Max(rhs);
+  }
+
+  /**
+   * Compares two serialized values of a fixed-size type without deserializing them into Values.
+   * @param type_id the type of both values
+   * @param lhs the serialized left value
+   * @param rhs the serialized right value
+   * @param[out] result -1 if lhs < rhs, 1 if lhs > rhs and 0 otherwise
+   * @return false, leaving result alone, if the type is not fixed-size or either value is NULL
+   */
+  static bool CompareSerialized(TypeId type_id, const char *lhs, const char *rhs, int *result) {
+    bool is_null = false;
+    int cmp = 0;
+    bool is_fixed = TypeSwitch(type_id, [&](auto tag) {
+      using Native = NativeType<decltype(tag)::value>;
+      typename Native::T left;
+      typename Native::T right;
+      memcpy(&left, lhs, sizeof(left));
+      memcpy(&right, rhs, sizeof(right));
+      is_null = left == Native::NULL_VALUE || right == Native::NULL_VALUE;
+      cmp = left < right ? -1 : (left > right ? 1 : 0);
+    });
+    if (!is_fixed || is_null) {
+      return false;
+    }
+    *result = cmp;
+    return true;
+  }
+
+ private:
+  static bool IsSameNonNull(const Value &lhs, const Value &rhs) {
+    return lhs.GetTypeId() == rhs.GetTypeId() && !lhs.IsNull() && !rhs.IsNull();
+  }
+
+  template <typename Op>
+  static CmpBool Compare(const Value &lhs, const Value &rhs, CmpBool (Value::*generic)(const Value &) const) {
+    CmpBool result = CmpBool::CmpNull;
+    if (IsSameNonNull(lhs, rhs) && TypeSwitch(lhs.GetTypeId(), [&](auto tag) {
+          using T = typename NativeType<decltype(tag)::value>::T;
+          result = GetCmpBool(Op{}(lhs.GetAs<T>(), rhs.GetAs<T>()));
+        })) {
+      return result;
+    }
+    return (lhs.*generic)(rhs);
+  }
+};
+
+}  // namespace bustub
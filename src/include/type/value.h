@@ -68,6 +68,7 @@ class Value {
     std::swap(first.value_, second.value_);
     std::swap(first.size_, second.size_);
     std::swap(first.manage_data_, second.manage_data_);
+    std::swap(first.is_inlined_, second.is_inlined_);
     std::swap(first.type_id_, second.type_id_);
   }
   // check whether value is integer
@@ -138,6 +139,15 @@ class Value {
   inline Value Copy() const { return Type::GetInstance(type_id_)->Copy(*this); }
 
  protected:
+  // The number of bytes of variable length data that are stored in the value itself, rather than on the heap
+  static constexpr uint32_t INLINE_VARLEN_SIZE = 16;
+
+  // Get the variable length data, wherever it is stored
+  inline const char *GetVarlenData() const { return is_inlined_ ? value_.inline_varlen_ : value_.const_varlen_; }
+
+  // Store a copy of the variable length data, inline if it is short enough
+  void CopyVarlenData(const char *data, uint32_t len);
+
   // The actual value item
   union Val {
     int8_t boolean_;
@@ -149,6 +159,7 @@ class Value {
     uint64_t timestamp_;
     char *varlen_;
     const char *const_varlen_;
+    char inline_varlen_[INLINE_VARLEN_SIZE];
   } value_;
 
   union {
@@ -157,6 +168,8 @@ class Value {
   } size_;
 
   bool manage_data_;
+  // Whether variable length data is stored in value_.inline_varlen_; manage_data_ is false then
+  bool is_inlined_{false};
   // The data type
   TypeId type_id_;
 };
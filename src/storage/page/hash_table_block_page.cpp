@@ -11,36 +11,77 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/page/hash_table_block_page.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "storage/index/generic_key.h"
 
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 KeyType HASH_TABLE_BLOCK_TYPE::KeyAt(slot_offset_t bucket_ind) const {
-  return {};
+  return array_[bucket_ind].first;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 ValueType HASH_TABLE_BLOCK_TYPE::ValueAt(slot_offset_t bucket_ind) const {
-  return {};
+  return array_[bucket_ind].second;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_BLOCK_TYPE::Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) {
-  return false;
+bool HASH_TABLE_BLOCK_TYPE::Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value,
+                                   uint8_t fingerprint) {
+  if (ctrl_[bucket_ind] != CTRL_EMPTY) {
+    return false;
+  }
+  array_[bucket_ind] = MappingType(key, value);
+  ctrl_[bucket_ind] = CTRL_READABLE | fingerprint;
+  return true;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind) {}
+void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind) {
+  ctrl_[bucket_ind] = CTRL_TOMBSTONE;
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BLOCK_TYPE::IsOccupied(slot_offset_t bucket_ind) const {
-  return false;
+  return ctrl_[bucket_ind] != CTRL_EMPTY;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BLOCK_TYPE::IsReadable(slot_offset_t bucket_ind) const {
-  return false;
+  return (ctrl_[bucket_ind] & CTRL_READABLE) != 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BLOCK_TYPE::MatchFingerprint(slot_offset_t group_ind, uint8_t fingerprint) const {
+  return MatchControl(group_ind, CTRL_READABLE | fingerprint);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BLOCK_TYPE::MatchEmpty(slot_offset_t group_ind) const {
+  return MatchControl(group_ind, CTRL_EMPTY);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BLOCK_TYPE::MatchControl(slot_offset_t group_ind, uint8_t ctrl) const {
+#ifdef __SSE2__
+  static_assert(BLOCK_GROUP_SIZE == sizeof(__m128i), "a group is probed with one SSE2 compare");
+  __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl_ + group_ind));
+  __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(ctrl)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(match));
+#else
+  uint32_t mask = 0;
+  for (uint32_t i = 0; i < BLOCK_GROUP_SIZE; i++) {
+    if (ctrl_[group_ind + i] == ctrl) {
+      mask |= 1U << i;
+    }
+  }
+  return mask;
+#endif
 }
 
 // DO NOT REMOVE ANYTHING BELOW THIS LINE
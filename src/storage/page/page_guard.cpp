@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_guard.cpp
+//
+// Identification: src/storage/page/page_guard.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/page_guard.h"
+
+#include <utility>
+
+namespace bustub {
+
+PageGuard::PageGuard(BufferPoolManager *bpm, Page *page) : bpm_(bpm), page_(page) {
+  if (page_ != nullptr) {
+    pinned_at_ = std::chrono::steady_clock::now();
+  }
+}
+
+PageGuard::PageGuard(PageGuard &&other) noexcept
+    : bpm_(other.bpm_), page_(other.page_), is_dirty_(other.is_dirty_), pinned_at_(other.pinned_at_) {
+  other.page_ = nullptr;
+  other.is_dirty_ = false;
+}
+
+PageGuard &PageGuard::operator=(PageGuard &&other) noexcept {
+  if (this != &other) {
+    Drop();
+    bpm_ = other.bpm_;
+    page_ = other.page_;
+    is_dirty_ = other.is_dirty_;
+    pinned_at_ = other.pinned_at_;
+    other.page_ = nullptr;
+    other.is_dirty_ = false;
+  }
+  return *this;
+}
+
+void PageGuard::Drop() {
+  if (page_ == nullptr) {
+    return;
+  }
+  bpm_->UnpinPage(page_->GetPageId(), is_dirty_);
+  bpm_->RecordPinDuration(std::chrono::steady_clock::now() - pinned_at_);
+  page_ = nullptr;
+  is_dirty_ = false;
+}
+
+ReadPageGuard::ReadPageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {
+  if (page != nullptr) {
+    page->RLatch();
+  }
+}
+
+ReadPageGuard &ReadPageGuard::operator=(ReadPageGuard &&other) noexcept {
+  if (this != &other) {
+    Drop();
+    guard_ = std::move(other.guard_);
+  }
+  return *this;
+}
+
+void ReadPageGuard::Drop() {
+  if (guard_.IsValid()) {
+    guard_.GetPage()->RUnlatch();
+  }
+  guard_.Drop();
+}
+
+WritePageGuard::WritePageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {
+  if (page != nullptr) {
+    page->WLatch();
+  }
+}
+
+WritePageGuard &WritePageGuard::operator=(WritePageGuard &&other) noexcept {
+  if (this != &other) {
+    Drop();
+    guard_ = std::move(other.guard_);
+  }
+  return *this;
+}
+
+void WritePageGuard::Drop() {
+  if (guard_.IsValid()) {
+    guard_.GetPage()->WUnlatch();
+  }
+  guard_.Drop();
+}
+
+}  // namespace bustub
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_range_dispenser.cpp
+//
+// Identification: src/storage/table/page_range_dispenser.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/page_range_dispenser.h"
+
+#include "common/exception.h"
+#include "storage/page/page_guard.h"
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+PageRangeDispenser::PageRangeDispenser(BufferPoolManager *bpm, page_id_t first_page_id, uint32_t num_workers,
+                                       uint32_t range_size)
+    : bpm_(bpm), range_size_(range_size), queues_(num_workers), next_page_id_(first_page_id) {}
+
+page_id_t PageRangeDispenser::Next(uint32_t worker_id) {
+  WorkerQueue &queue = queues_[worker_id];
+  while (true) {
+    {
+      std::scoped_lock latch(queue.latch_);
+      if (!queue.pages_.empty()) {
+        page_id_t page_id = queue.pages_.front();
+        queue.pages_.pop_front();
+        return page_id;
+      }
+    }
+    if (!ClaimRange(worker_id) && !Steal(worker_id)) {
+      // Pages still queued elsewhere belong to workers that will scan them.
+      return INVALID_PAGE_ID;
+    }
+  }
+}
+
+bool PageRangeDispenser::ClaimRange(uint32_t worker_id) {
+  std::vector<page_id_t> range;
+  {
+    std::scoped_lock latch(list_latch_);
+    // Only the header of each page is read here; the claiming worker will find the pages in the pool when it
+    // scans them.
+    while (range.size() < range_size_ && next_page_id_ != INVALID_PAGE_ID) {
+      ReadPageGuard guard = bpm_->FetchPageRead(next_page_id_);
+      if (!guard.IsValid()) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "PageRangeDispenser could not fetch a table page.");
+      }
+      range.push_back(next_page_id_);
+      next_page_id_ = guard.As<TablePage>()->GetNextPageId();
+    }
+  }
+  if (range.empty()) {
+    return false;
+  }
+  WorkerQueue &queue = queues_[worker_id];
+  std::scoped_lock latch(queue.latch_);
+  queue.pages_.insert(queue.pages_.end(), range.begin(), range.end());
+  return true;
+}
+
+bool PageRangeDispenser::Steal(uint32_t worker_id) {
+  while (true) {
+    uint32_t victim = worker_id;
+    size_t most_pages = 0;
+    for (uint32_t i = 0; i < queues_.size(); i++) {
+      if (i == worker_id) {
+        continue;
+      }
+      std::scoped_lock latch(queues_[i].latch_);
+      if (queues_[i].pages_.size() > most_pages) {
+        most_pages = queues_[i].pages_.size();
+        victim = i;
+      }
+    }
+    if (victim == worker_id) {
+      return false;
+    }
+
+    std::vector<page_id_t> stolen;
+    {
+      std::scoped_lock latch(queues_[victim].latch_);
+      auto &pages = queues_[victim].pages_;
+      // Leave the victim the pages it will scan next; take the far end, rounding up so a single page moves too.
+      size_t num_stolen = (pages.size() + 1) / 2;
+      stolen.assign(pages.end() - num_stolen, pages.end());
+      pages.erase(pages.end() - num_stolen, pages.end());
+    }
+    if (stolen.empty()) {
+      // The victim drained its queue in the meantime; look again.
+      continue;
+    }
+    std::scoped_lock latch(queues_[worker_id].latch_);
+    queues_[worker_id].pages_.insert(queues_[worker_id].pages_.end(), stolen.begin(), stolen.end());
+    return true;
+  }
+}
+
+}  // namespace bustub
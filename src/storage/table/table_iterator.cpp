@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <cassert>
+#include <utility>
 
+#include "storage/page/page_guard.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -35,32 +37,26 @@ Tuple *TableIterator::operator->() {
 
 TableIterator &TableIterator::operator++() {
   BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(tuple_->rid_.GetPageId()));
-  cur_page->RLatch();
-  assert(cur_page != nullptr);  // all pages are pinned
+  auto guard = buffer_pool_manager->FetchPageRead(tuple_->rid_.GetPageId());
+  assert(guard.IsValid());  // all pages are pinned
 
   RID next_tuple_rid;
-  if (!cur_page->GetNextTupleRid(tuple_->rid_,
-                                 &next_tuple_rid)) {  // end of this page
-    while (cur_page->GetNextPageId() != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(cur_page->GetNextPageId()));
-      cur_page->RUnlatch();
-      buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
-      cur_page->RLatch();
-      if (cur_page->GetFirstTupleRid(&next_tuple_rid)) {
+  if (!guard.As<TablePage>()->GetNextTupleRid(tuple_->rid_, &next_tuple_rid)) {  // end of this page
+    while (guard.As<TablePage>()->GetNextPageId() != INVALID_PAGE_ID) {
+      // Latch the next page before letting go of this one.
+      auto next_guard = buffer_pool_manager->FetchPageRead(guard.As<TablePage>()->GetNextPageId());
+      guard = std::move(next_guard);
+      if (guard.As<TablePage>()->GetFirstTupleRid(&next_tuple_rid)) {
         break;
       }
     }
   }
   tuple_->rid_ = next_tuple_rid;
 
+  // Copy the tuple out of the page we already hold, rather than fetching it again.
   if (*this != table_heap_->End()) {
-    table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
+    guard.As<TablePage>()->GetTuple(tuple_->rid_, tuple_, txn_, table_heap_->lock_manager_);
   }
-  // release until copy the tuple
-  cur_page->RUnlatch();
-  buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
   return *this;
 }
 
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include <string>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::~TmpTupleFile() {
+  Finish();
+  for (page_id_t page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple, TmpTuple *out) {
+  if (tuple.GetLength() > TmpTuplePage::MaxTupleSize()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Tuple is too large to spill to a temporary page.");
+  }
+  if (tail_ == nullptr && !page_ids_.empty()) {
+    Page *page = bpm_->FetchPage(page_ids_.back());
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot fetch page " + std::to_string(page_ids_.back()));
+    }
+    tail_ = reinterpret_cast<TmpTuplePage *>(page);
+  }
+
+  TmpTuple location(INVALID_PAGE_ID, 0);
+  if (tail_ == nullptr || !tail_->Insert(tuple, &location)) {
+    Finish();
+    page_id_t page_id;
+    Page *page = bpm_->NewPage(&page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate a temporary page");
+    }
+    tail_ = reinterpret_cast<TmpTuplePage *>(page);
+    tail_->Init(page_id, PAGE_SIZE);
+    page_ids_.push_back(page_id);
+    tail_->Insert(tuple, &location);
+  }
+
+  num_tuples_++;
+  num_bytes_ += tuple.GetLength();
+  if (out != nullptr) {
+    *out = location;
+  }
+}
+
+void TmpTupleFile::Finish() {
+  if (tail_ != nullptr) {
+    bpm_->UnpinPage(tail_->GetTablePageId(), true);
+    tail_ = nullptr;
+  }
+}
+
+TmpTupleFile::Reader::~Reader() {
+  if (page_ != nullptr) {
+    file_->bpm_->UnpinPage(page_->GetTablePageId(), false);
+  }
+}
+
+bool TmpTupleFile::Reader::Next(Tuple *tuple) {
+  while (offsets_.empty()) {
+    if (page_ != nullptr) {
+      file_->bpm_->UnpinPage(page_->GetTablePageId(), false);
+      page_ = nullptr;
+    }
+    if (next_page_idx_ >= file_->page_ids_.size()) {
+      return false;
+    }
+    page_id_t page_id = file_->page_ids_[next_page_idx_++];
+    Page *page = file_->bpm_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot fetch page " + std::to_string(page_id));
+    }
+    page_ = reinterpret_cast<TmpTuplePage *>(page);
+
+    // Tuples are stacked from the end of the page, so walking up from the free space pointer visits them newest
+    // first; the offsets are consumed from the back to read them oldest first.
+    for (uint32_t offset = page_->GetFreeSpacePointer(); offset < PAGE_SIZE; offset = page_->GetNextOffset(offset)) {
+      offsets_.push_back(offset);
+    }
+  }
+
+  page_->Get(offsets_.back(), tuple);
+  offsets_.pop_back();
+  return true;
+}
+
+}  // namespace bustub
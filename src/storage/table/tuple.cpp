@@ -23,19 +23,29 @@ namespace bustub {
 // TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
 Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true) {
   assert(values.size() == schema->GetColumnCount());
+  size_ = SerializedSize(values, schema);
+  data_ = new char[size_];
+  SerializeValues(values, schema);
+}
+
+Tuple::Tuple(const std::vector<Value> &values, const Schema *schema, Arena *arena) {
+  assert(values.size() == schema->GetColumnCount());
+  size_ = SerializedSize(values, schema);
+  data_ = arena->Allocate(size_, alignof(uint32_t));
+  SerializeValues(values, schema);
+}
 
-  // 1. Calculate the size of the tuple.
+uint32_t Tuple::SerializedSize(const std::vector<Value> &values, const Schema *schema) {
   uint32_t tuple_size = schema->GetLength();
   for (auto &i : schema->GetUnlinedColumns()) {
     tuple_size += (values[i].GetLength() + sizeof(uint32_t));
   }
+  return tuple_size;
+}
 
-  // 2. Allocate memory.
-  size_ = tuple_size;
-  data_ = new char[size_];
+void Tuple::SerializeValues(const std::vector<Value> &values, const Schema *schema) {
   std::memset(data_, 0, size_);
 
-  // 3. Serialize each attribute based on the input value.
   uint32_t column_count = schema->GetColumnCount();
   uint32_t offset = schema->GetLength();
 
@@ -67,6 +77,18 @@ Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_
   }
 }
 
+Tuple::Tuple(const Tuple &other, Arena *arena) : rid_(other.rid_), size_(other.size_) {
+  data_ = arena->Allocate(size_, alignof(uint32_t));
+  memcpy(data_, other.data_, size_);
+}
+
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_), data_(other.data_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
 Tuple &Tuple::operator=(const Tuple &other) {
   if (allocated_) {
     delete[] data_;
@@ -87,6 +109,23 @@ Tuple &Tuple::operator=(const Tuple &other) {
   return *this;
 }
 
+Tuple &Tuple::operator=(Tuple &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = other.allocated_;
+  rid_ = other.rid_;
+  size_ = other.size_;
+  data_ = other.data_;
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
 Value Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const {
   assert(schema);
   assert(data_);
@@ -162,4 +201,13 @@ void Tuple::DeserializeFrom(const char *storage) {
   this->allocated_ = true;
 }
 
+Tuple Tuple::Materialize() const {
+  Tuple copy(rid_);
+  copy.size_ = size_;
+  copy.data_ = new char[size_];
+  memcpy(copy.data_, data_, size_);
+  copy.allocated_ = true;
+  return copy;
+}
+
 }  // namespace bustub
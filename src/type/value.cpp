@@ -22,12 +22,14 @@ Value::Value(const Value &other) {
   type_id_ = other.type_id_;
   size_ = other.size_;
   manage_data_ = other.manage_data_;
+  is_inlined_ = other.is_inlined_;
   value_ = other.value_;
   switch (type_id_) {
     case TypeId::VARCHAR:
       if (size_.len_ == BUSTUB_VALUE_NULL) {
         value_.varlen_ = nullptr;
       } else {
+        // Inline data was copied along with value_.
         if (manage_data_) {
           value_.varlen_ = new char[size_.len_];
           memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
@@ -218,13 +220,9 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
         value_.varlen_ = nullptr;
         size_.len_ = BUSTUB_VALUE_NULL;
       } else {
-        manage_data_ = manage_data;
-        if (manage_data_) {
+        if (manage_data) {
           assert(len < BUSTUB_VARCHAR_MAX_LEN);
-          value_.varlen_ = new char[len];
-          assert(value_.varlen_ != nullptr);
-          size_.len_ = len;
-          memcpy(value_.varlen_, data, len);
+          CopyVarlenData(data, len);
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen_ = data;
@@ -240,13 +238,8 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
 Value::Value(TypeId type, const std::string &data) : Value(type) {
   switch (type) {
     case TypeId::VARCHAR: {
-      manage_data_ = true;
       // TODO(TAs): How to represent a null string here?
-      uint32_t len = static_cast<uint32_t>(data.length()) + 1;
-      value_.varlen_ = new char[len];
-      assert(value_.varlen_ != nullptr);
-      size_.len_ = len;
-      memcpy(value_.varlen_, data.c_str(), len);
+      CopyVarlenData(data.c_str(), static_cast<uint32_t>(data.length()) + 1);
       break;
     }
     default:
@@ -254,6 +247,20 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
   }
 }
 
+void Value::CopyVarlenData(const char *data, uint32_t len) {
+  size_.len_ = len;
+  if (len <= INLINE_VARLEN_SIZE) {
+    // Short strings are the common case; keeping them inline saves an allocation on every copy.
+    is_inlined_ = true;
+    manage_data_ = false;
+    memcpy(value_.inline_varlen_, data, len);
+  } else {
+    manage_data_ = true;
+    value_.varlen_ = new char[len];
+    memcpy(value_.varlen_, data, len);
+  }
+}
+
 // delete allocated char array space
 Value::~Value() {
   switch (type_id_) {
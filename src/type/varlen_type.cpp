@@ -41,7 +41,7 @@ VarlenType::VarlenType(TypeId type) : Type(type) {}
 VarlenType::~VarlenType() = default;
 
 // Access the raw variable length data
-const char *VarlenType::GetData(const Value &val) const { return val.value_.varlen_; }
+const char *VarlenType::GetData(const Value &val) const { return val.GetVarlenData(); }
 
 // Get the length of the variable length data (including the length field)
 uint32_t VarlenType::GetLength(const Value &val) const { return val.size_.len_; }
@@ -162,7 +162,7 @@ void VarlenType::SerializeTo(const Value &val, char *storage) const {
     return;
   }
   memcpy(storage, &len, sizeof(uint32_t));
-  memcpy(storage + sizeof(uint32_t), val.value_.varlen_, len);
+  memcpy(storage + sizeof(uint32_t), val.GetVarlenData(), len);
 }
 
 // Deserialize a value of the given type from the given storage space.
@@ -171,7 +171,7 @@ Value VarlenType::DeserializeFrom(const char *storage) const {
   if (len == BUSTUB_VALUE_NULL) {
     return Value(type_id_, nullptr, len, false);
   }
-  // set manage_data as true
+  // copy the data, so the value does not depend on the storage
   return Value(type_id_, storage + sizeof(uint32_t), len, true);
 }
 
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_test.cpp
+//
+// Identification: test/common/arena_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/util/arena.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, AllocateTest) {
+  Arena arena(1024);
+  EXPECT_EQ(0, arena.GetMemoryUsage());
+
+  // Small allocations are aligned, do not overlap and share blocks.
+  std::vector<char *> allocations;
+  for (size_t i = 0; i < 100; i++) {
+    char *data = arena.Allocate(24, 8);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(data) % 8);
+    memset(data, static_cast<int>(i), 24);
+    allocations.push_back(data);
+  }
+  for (size_t i = 0; i < allocations.size(); i++) {
+    EXPECT_EQ(static_cast<char>(i), allocations[i][0]);
+    EXPECT_EQ(static_cast<char>(i), allocations[i][23]);
+  }
+  EXPECT_EQ(2400, arena.GetBytesAllocated());
+  EXPECT_EQ(3 * 1024, arena.GetMemoryUsage());
+
+  // A large allocation gets a block of its own, and small ones continue in the current block.
+  char *small = arena.Allocate(8, 8);
+  char *large = arena.Allocate(4096);
+  memset(large, 1, 4096);
+  EXPECT_EQ(small + 8, arena.Allocate(8, 8));
+  EXPECT_LT(3 * 1024 + 4096, arena.GetMemoryUsage());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, ResetTest) {
+  Arena arena(1024);
+  char *first = arena.Allocate(16);
+  for (size_t i = 0; i < 100; i++) {
+    arena.Allocate(100);
+  }
+  arena.Allocate(4096);
+
+  // Resetting frees all but the first block, which is reused from its start.
+  arena.Reset();
+  EXPECT_EQ(0, arena.GetBytesAllocated());
+  EXPECT_EQ(1024, arena.GetMemoryUsage());
+  EXPECT_EQ(first, arena.Allocate(16));
+}
+
+}  // namespace bustub
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hyper_log_log_test.cpp
+//
+// Identification: test/common/hyper_log_log_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "common/util/hyper_log_log.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(HyperLogLogTest, EstimateTest) {
+  HyperLogLog hll;
+  EXPECT_EQ(0, hll.Estimate());
+
+  // Small counts are exact or nearly so; adding a value again changes nothing.
+  for (uint64_t i = 0; i < 100; i++) {
+    hll.Add(HashUtil::Mix64(i));
+    hll.Add(HashUtil::Mix64(i));
+  }
+  EXPECT_NEAR(100, hll.Estimate(), 2);
+
+  // Large counts are within a few standard errors.
+  for (uint64_t i = 100; i < 100000; i++) {
+    hll.Add(HashUtil::Mix64(i));
+  }
+  EXPECT_NEAR(100000, hll.Estimate(), 5000);
+}
+
+// NOLINTNEXTLINE
+TEST(HyperLogLogTest, MergeTest) {
+  HyperLogLog left;
+  HyperLogLog right;
+  HyperLogLog both;
+  for (uint64_t i = 0; i < 50000; i++) {
+    // The halves overlap, so the union has 40000 values.
+    (i % 2 == 0 ? left : right).Add(HashUtil::Mix64(i % 40000));
+    both.Add(HashUtil::Mix64(i % 40000));
+  }
+
+  // Merging is the sketch of the union, whichever way round.
+  HyperLogLog reversed = right;
+  reversed.Merge(left);
+  left.Merge(right);
+  EXPECT_EQ(both.Estimate(), left.Estimate());
+  EXPECT_EQ(both.Estimate(), reversed.Estimate());
+  EXPECT_NEAR(40000, both.Estimate(), 2000);
+}
+
+// NOLINTNEXTLINE
+TEST(HyperLogLogTest, SerializeTest) {
+  // Sketches with few registers set are written sparsely, full ones packed; both read back the same.
+  for (uint64_t num_values : {0, 10, 1000, 100000}) {
+    HyperLogLog hll;
+    for (uint64_t i = 0; i < num_values; i++) {
+      hll.Add(HashUtil::Mix64(i));
+    }
+    std::vector<char> storage(HyperLogLog::MAX_SERIALIZED_SIZE);
+    hll.SerializeTo(storage.data());
+    EXPECT_EQ(hll.GetSerializedSize(), HyperLogLog::SerializedSize(storage.data()));
+    EXPECT_LE(hll.GetSerializedSize(), HyperLogLog::MAX_SERIALIZED_SIZE);
+    HyperLogLog restored;
+    restored.Add(HashUtil::Mix64(num_values + 1));
+    restored.DeserializeFrom(storage.data());
+    EXPECT_EQ(hll.Estimate(), restored.Estimate());
+    // Merging the restored sketch back changes nothing.
+    HyperLogLog merged = hll;
+    merged.Merge(restored);
+    EXPECT_EQ(hll.Estimate(), merged.Estimate());
+  }
+  HyperLogLog small;
+  small.Add(HashUtil::Mix64(1));
+  EXPECT_LT(small.GetSerializedSize(), 8);
+}
+
+}  // namespace bustub
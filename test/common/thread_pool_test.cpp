@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// thread_pool_test.cpp
+//
+// Identification: test/common/thread_pool_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "execution/exchange_queue.h"
+#include "execution/parallel_context.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolTest, RunsEveryTaskTest) {
+  std::atomic<int> sum{0};
+  {
+    ThreadPool pool(4);
+    EXPECT_EQ(4, pool.GetNumThreads());
+    for (int i = 1; i <= 1000; i++) {
+      pool.Submit([&sum, i] { sum += i; });
+    }
+    // The destructor runs the tasks still queued.
+  }
+  EXPECT_EQ(500500, sum);
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolTest, ReserveTest) {
+  ThreadPool pool(4);
+  std::atomic<bool> release{false};
+  // Every thread is taken by a task that blocks until it is released.
+  for (int i = 0; i < 4; i++) {
+    pool.Submit([&release] {
+      while (!release) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  EXPECT_EQ(0, pool.TryReserve(1));
+  release = true;
+
+  // Once the blocking tasks are done, every thread can be reserved, but no more than that.
+  size_t num_reserved = 0;
+  while (num_reserved < 4) {
+    num_reserved += pool.TryReserve(4 - num_reserved);
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(0, pool.TryReserve(1));
+
+  // Tasks that wait for each other all run on their reserved threads.
+  ParallelContext parallel_ctx(4);
+  std::atomic<int> passed{0};
+  for (int i = 0; i < 4; i++) {
+    pool.SubmitReserved([&] {
+      parallel_ctx.ArriveAndWait();
+      passed++;
+    });
+  }
+  while (passed < 4) {
+    std::this_thread::yield();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolTest, ExchangeQueueTest) {
+  const uint32_t num_producers = 4;
+  const int batches_per_producer = 200;
+  ThreadPool pool(num_producers);
+  ExchangeQueue queue(num_producers, 2);
+  for (uint32_t producer = 0; producer < num_producers; producer++) {
+    pool.Submit([&queue, producer] {
+      for (int i = 0; i < batches_per_producer; i++) {
+        TupleBatch batch(1);
+        batch.Append(Tuple(), RID(producer, i));
+        queue.Push(std::move(batch));
+      }
+      queue.ProducerDone();
+    });
+  }
+
+  // Each producer's batches arrive in order, however they interleave.
+  std::vector<int> next(num_producers, 0);
+  TupleBatch batch;
+  int num_batches = 0;
+  while (queue.Pop(&batch)) {
+    ASSERT_EQ(1, batch.Size());
+    RID rid = batch.GetRid(0);
+    EXPECT_EQ(next[rid.GetPageId()]++, rid.GetSlotNum());
+    num_batches++;
+  }
+  EXPECT_EQ(num_producers * batches_per_producer, num_batches);
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolTest, ExchangeQueueCloseTest) {
+  ThreadPool pool(2);
+  ExchangeQueue queue(2, 1);
+  std::atomic<int> refused{0};
+  for (int producer = 0; producer < 2; producer++) {
+    pool.Submit([&queue, &refused] {
+      // Blocks on the full queue until the consumer closes it.
+      while (queue.Push(TupleBatch())) {
+      }
+      refused++;
+      queue.ProducerDone();
+    });
+  }
+  TupleBatch batch;
+  ASSERT_TRUE(queue.Pop(&batch));
+  queue.Close();
+  queue.WaitForProducers();
+  EXPECT_EQ(2, refused);
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolTest, BarrierTest) {
+  const uint32_t num_workers = 4;
+  const int rounds = 100;
+  ParallelContext parallel_ctx(num_workers);
+  std::atomic<int> arrived{0};
+  std::atomic<bool> overtaken{false};
+  {
+    ThreadPool pool(num_workers);
+    for (uint32_t i = 0; i < num_workers; i++) {
+      pool.Submit([&] {
+        for (int round = 0; round < rounds; round++) {
+          arrived++;
+          parallel_ctx.ArriveAndWait();
+          // No worker gets past a barrier before every worker has reached it.
+          if (arrived < static_cast<int>(num_workers) * (round + 1)) {
+            overtaken = true;
+          }
+          parallel_ctx.ArriveAndWait();
+        }
+      });
+    }
+  }
+  EXPECT_FALSE(overtaken);
+
+  // Once aborted, a barrier that can never be completed throws instead of blocking.
+  parallel_ctx.Abort();
+  EXPECT_THROW(parallel_ctx.ArriveAndWait(), Exception);
+}
+
+}  // namespace bustub
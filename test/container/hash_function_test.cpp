@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_function_test.cpp
+//
+// Identification: test/container/hash_function_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <vector>
+
+#include "common/logger.h"
+#include "container/hash/hash_function.h"
+#include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+// the hash every key type used before the specializations, kept as the benchmark baseline
+template <typename KeyType>
+uint64_t MurmurHash(const KeyType &key) {
+  uint64_t hash[2];
+  murmur3::MurmurHash3_x64_128(reinterpret_cast<const void *>(&key), static_cast<int>(sizeof(KeyType)), 0,
+                               reinterpret_cast<void *>(&hash));
+  return hash[0];
+}
+
+// NOLINTNEXTLINE
+TEST(HashFunctionTest, IntegralKeyTest) {
+  HashFunction<int> hash_fn;
+  EXPECT_EQ(hash_fn.GetHash(42), hash_fn.GetHash(42));
+  EXPECT_NE(hash_fn.GetHash(42), hash_fn.GetHash(43));
+
+  // consecutive keys must spread over both the low bits (slot) and the high bits (fingerprint)
+  const int num_keys = 1 << 16;
+  std::vector<int> low_buckets(64, 0);
+  std::vector<int> high_buckets(64, 0);
+  for (int key = 0; key < num_keys; key++) {
+    uint64_t hash = hash_fn.GetHash(key);
+    low_buckets[hash & 63]++;
+    high_buckets[hash >> 58]++;
+  }
+  for (int i = 0; i < 64; i++) {
+    EXPECT_GT(low_buckets[i], num_keys / 64 / 2);
+    EXPECT_GT(high_buckets[i], num_keys / 64 / 2);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashFunctionTest, GenericKeyLengthTest) {
+  GenericKey<64> key1;
+  GenericKey<64> key2;
+  key1.SetFromInteger(12345);
+  key2.SetFromInteger(12345);
+  // bytes past the key length do not take part in the hash
+  key2.data_[60] = 1;
+
+  HashFunction<GenericKey<64>> length_aware(8);
+  EXPECT_EQ(length_aware.GetHash(key1), length_aware.GetHash(key2));
+  HashFunction<GenericKey<64>> whole_key;
+  EXPECT_NE(whole_key.GetHash(key1), whole_key.GetHash(key2));
+
+  key2.SetFromInteger(12346);
+  EXPECT_NE(length_aware.GetHash(key1), length_aware.GetHash(key2));
+}
+
+// Not a correctness test: reports the cost of each hash variant.
+// NOLINTNEXTLINE
+TEST(HashFunctionTest, DISABLED_HashBenchmark) {
+  const int num_keys = 10000000;
+  uint64_t sink = 0;
+
+  auto time_ms = [](auto start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (int key = 0; key < num_keys; key++) {
+    sink += MurmurHash(key);
+  }
+  LOG_INFO("int, murmur3 x64_128: %ld ms", time_ms(start));
+
+  HashFunction<int> int_hash;
+  start = std::chrono::steady_clock::now();
+  for (int key = 0; key < num_keys; key++) {
+    sink += int_hash.GetHash(key);
+  }
+  LOG_INFO("int, Mix64: %ld ms", time_ms(start));
+
+  GenericKey<64> generic_key;
+  start = std::chrono::steady_clock::now();
+  for (int key = 0; key < num_keys; key++) {
+    generic_key.SetFromInteger(key);
+    sink += MurmurHash(generic_key);
+  }
+  LOG_INFO("GenericKey<64> with an 8 byte key, murmur3 x64_128 over 64 bytes: %ld ms", time_ms(start));
+
+  HashFunction<GenericKey<64>> generic_hash(8);
+  start = std::chrono::steady_clock::now();
+  for (int key = 0; key < num_keys; key++) {
+    generic_key.SetFromInteger(key);
+    sink += generic_hash.GetHash(generic_key);
+  }
+  LOG_INFO("GenericKey<64> with an 8 byte key, length aware: %ld ms", time_ms(start));
+
+  // keep the loops from being optimized away
+  EXPECT_NE(0, sink);
+}
+
+}  // namespace bustub
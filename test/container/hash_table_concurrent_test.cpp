@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_table_concurrent_test.cpp
+//
+// Identification: test/container/hash_table_concurrent_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/logger.h"
+#include "container/hash/linear_probe_hash_table.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+// helper function to launch multiple threads
+template <typename... Args>
+void LaunchParallelTest(uint64_t num_threads, Args &&... args) {
+  std::vector<std::thread> thread_group;
+
+  // Launch a group of threads
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group.push_back(std::thread(args..., thread_itr));
+  }
+
+  // Join the threads with the main thread
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group[thread_itr].join();
+  }
+}
+
+// helper function to insert the keys owned by one thread
+void InsertHelper(LinearProbeHashTable<int, int, IntComparator> *ht, int num_keys, int total_threads,
+                  uint64_t thread_itr) {
+  for (int key = 0; key < num_keys; key++) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      ht->Insert(nullptr, key, key);
+    }
+  }
+}
+
+// helper function to insert every key from every thread
+void InsertAllHelper(LinearProbeHashTable<int, int, IntComparator> *ht, int num_keys,
+                     __attribute__((unused)) uint64_t thread_itr = 0) {
+  for (int key = 0; key < num_keys; key++) {
+    ht->Insert(nullptr, key, key);
+  }
+}
+
+// helper function to look up the keys owned by one thread
+void LookupHelper(LinearProbeHashTable<int, int, IntComparator> *ht, int num_keys, int total_threads,
+                  uint64_t thread_itr) {
+  for (int key = 0; key < num_keys; key++) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      std::vector<int> res;
+      ht->GetValue(nullptr, key, &res);
+    }
+  }
+}
+
+// helper function to remove the keys owned by one thread
+void RemoveHelper(LinearProbeHashTable<int, int, IntComparator> *ht, int num_keys, int total_threads,
+                  uint64_t thread_itr) {
+  for (int key = 0; key < num_keys; key++) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      ht->Remove(nullptr, key, key);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, DISABLED_InsertTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  // start small so that the inserting threads race with Resize
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+
+  const int num_keys = 5000;
+  LaunchParallelTest(4, InsertHelper, &ht, num_keys, 4);
+
+  for (int key = 0; key < num_keys; key++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, key, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to insert " << key;
+    EXPECT_EQ(key, res[0]);
+  }
+
+  LaunchParallelTest(4, RemoveHelper, &ht, num_keys, 4);
+  for (int key = 0; key < num_keys; key++) {
+    std::vector<int> res;
+    EXPECT_FALSE(ht.GetValue(nullptr, key, &res));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, DISABLED_DuplicateInsertTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+
+  // every thread inserts the same pairs; each pair must still end up in the table exactly once
+  const int num_keys = 1000;
+  LaunchParallelTest(4, InsertAllHelper, &ht, num_keys);
+
+  for (int key = 0; key < num_keys; key++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, key, &res);
+    EXPECT_EQ(1, res.size()) << "Wrong number of copies of " << key;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// Not a correctness test: reports insert and lookup throughput as the thread count grows.
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, DISABLED_InsertLookupBenchmark) {
+  const int num_keys = 100000;
+  for (uint64_t num_threads : {1, 2, 4, 8}) {
+    auto *disk_manager = new DiskManager("test.db");
+    auto *bpm = new BufferPoolManager(500, disk_manager);
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 2 * num_keys,
+                                                     HashFunction<int>());
+
+    auto start = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, InsertHelper, &ht, num_keys, num_threads);
+    auto inserted = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, LookupHelper, &ht, num_keys, num_threads);
+    auto looked_up = std::chrono::steady_clock::now();
+
+    auto insert_ms = std::chrono::duration_cast<std::chrono::milliseconds>(inserted - start).count();
+    auto lookup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(looked_up - inserted).count();
+    LOG_INFO("threads: %lu, insert %d keys: %ld ms, lookup %d keys: %ld ms", num_threads, num_keys, insert_ms,
+             num_keys, lookup_ms);
+
+    std::vector<int> res;
+    ht.GetValue(nullptr, num_keys - 1, &res);
+    EXPECT_EQ(1, res.size());
+
+    disk_manager->ShutDown();
+    remove("test.db");
+    delete disk_manager;
+    delete bpm;
+  }
+}
+
+}  // namespace bustub
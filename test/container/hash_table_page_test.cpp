@@ -17,7 +17,10 @@
 #include "common/logger.h"
 #include "gtest/gtest.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/index/generic_key.h"
 #include "storage/page/hash_table_block_page.h"
+#include "storage/page/hash_table_bucket_page.h"
+#include "storage/page/hash_table_directory_page.h"
 #include "storage/page/hash_table_header_page.h"
 
 namespace bustub {
@@ -73,8 +76,10 @@ TEST(HashTablePageTest, DISABLED_BlockPageSampleTest) {
 
   // insert a few (key, value) pairs
   for (unsigned i = 0; i < 10; i++) {
-    block_page->Insert(i, i, i);
+    block_page->Insert(i, i, i, i % 4);
   }
+  // an occupied slot cannot be claimed again
+  EXPECT_FALSE(block_page->Insert(0, 0, 0, 0));
 
   // check for the inserted pairs
   for (unsigned i = 0; i < 10; i++) {
@@ -103,6 +108,11 @@ TEST(HashTablePageTest, DISABLED_BlockPageSampleTest) {
     }
   }
 
+  // the first group matches fingerprints of readable slots only, and has empty slots from 10 on
+  EXPECT_EQ(0b0000000100010001, block_page->MatchFingerprint(0, 0));
+  EXPECT_EQ(0b0000000000000000, block_page->MatchFingerprint(0, 3));
+  EXPECT_EQ(0b1111110000000000, block_page->MatchEmpty(0));
+
   // unpin the header page now that we are done
   bpm->UnpinPage(block_page_id, true, nullptr);
   disk_manager->ShutDown();
@@ -111,4 +121,120 @@ TEST(HashTablePageTest, DISABLED_BlockPageSampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTablePageTest, DISABLED_DirectoryPageSampleTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(5, disk_manager);
+
+  // get a directory page from the BufferPoolManager
+  page_id_t directory_page_id = INVALID_PAGE_ID;
+  auto directory_page =
+      reinterpret_cast<HashTableDirectoryPage *>(bpm->NewPage(&directory_page_id, nullptr)->GetData());
+
+  EXPECT_EQ(0, directory_page->GetGlobalDepth());
+  directory_page->SetPageId(10);
+  EXPECT_EQ(10, directory_page->GetPageId());
+  directory_page->SetLSN(100);
+  EXPECT_EQ(100, directory_page->GetLSN());
+
+  // add a few hypothetical bucket pages
+  for (unsigned i = 0; i < 8; i++) {
+    directory_page->SetBucketPageId(i, i);
+  }
+
+  // check for correct bucket page IDs
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(i, directory_page->GetBucketPageId(i));
+  }
+
+  // doubling the directory mirrors the lower half into the upper half
+  directory_page->SetLocalDepth(0, 0);
+  directory_page->IncrGlobalDepth();
+  EXPECT_EQ(1, directory_page->GetGlobalDepth());
+  EXPECT_EQ(2, directory_page->Size());
+  EXPECT_EQ(directory_page->GetBucketPageId(0), directory_page->GetBucketPageId(1));
+  directory_page->VerifyIntegrity();
+
+  // split bucket 0 into buckets 0 and 1
+  directory_page->SetBucketPageId(1, 1);
+  directory_page->IncrLocalDepth(0);
+  directory_page->IncrLocalDepth(1);
+  EXPECT_EQ(1, directory_page->GetSplitImageIndex(0));
+  EXPECT_EQ(0, directory_page->GetSplitImageIndex(1));
+  EXPECT_EQ(2, directory_page->GetLocalHighBit(0));
+  EXPECT_FALSE(directory_page->CanShrink());
+  directory_page->VerifyIntegrity();
+
+  // unpin the directory page now that we are done
+  bpm->UnpinPage(directory_page_id, true, nullptr);
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(5, disk_manager);
+
+  // get a bucket page from the BufferPoolManager
+  page_id_t bucket_page_id = INVALID_PAGE_ID;
+
+  auto bucket_page = reinterpret_cast<HashTableBucketPage<int, int, IntComparator> *>(
+      bpm->NewPage(&bucket_page_id, nullptr)->GetData());
+
+  // insert a few (key, value) pairs
+  for (unsigned i = 0; i < 10; i++) {
+    EXPECT_TRUE(bucket_page->Insert(i, i, IntComparator()));
+  }
+  // duplicate (key, value) pairs are rejected
+  EXPECT_FALSE(bucket_page->Insert(0, 0, IntComparator()));
+  EXPECT_EQ(10, bucket_page->NumReadable());
+
+  // check for the inserted pairs
+  for (unsigned i = 0; i < 10; i++) {
+    EXPECT_EQ(i, bucket_page->KeyAt(i));
+    EXPECT_EQ(i, bucket_page->ValueAt(i));
+  }
+
+  // remove a few pairs
+  for (unsigned i = 0; i < 10; i++) {
+    if (i % 2 == 1) {
+      EXPECT_TRUE(bucket_page->Remove(i, i, IntComparator()));
+    }
+  }
+
+  // check for the flags
+  for (unsigned i = 0; i < 15; i++) {
+    if (i < 10) {
+      EXPECT_TRUE(bucket_page->IsOccupied(i));
+      if (i % 2 == 1) {
+        EXPECT_FALSE(bucket_page->IsReadable(i));
+      } else {
+        EXPECT_TRUE(bucket_page->IsReadable(i));
+      }
+    } else {
+      EXPECT_FALSE(bucket_page->IsOccupied(i));
+    }
+  }
+
+  // tombstones are reused before new slots
+  EXPECT_TRUE(bucket_page->Insert(20, 20, IntComparator()));
+  EXPECT_EQ(20, bucket_page->KeyAt(1));
+
+  std::vector<int> res;
+  EXPECT_TRUE(bucket_page->GetValue(20, IntComparator(), &res));
+  EXPECT_EQ(1, res.size());
+  EXPECT_FALSE(bucket_page->IsEmpty());
+  EXPECT_FALSE(bucket_page->IsFull());
+
+  // unpin the bucket page now that we are done
+  bpm->UnpinPage(bucket_page_id, true, nullptr);
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
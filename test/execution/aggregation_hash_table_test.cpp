@@ -0,0 +1,289 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table_test.cpp
+//
+// Identification: test/execution/aggregation_hash_table_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/logger.h"
+#include "execution/aggregation_hash_table.h"
+#include "gtest/gtest.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+const std::vector<AggregationType> ALL_AGGREGATES = {AggregationType::CountAggregate, AggregationType::SumAggregate,
+                                                     AggregationType::MinAggregate, AggregationType::MaxAggregate};
+
+/** Inserts a tuple with group by values (a, b) and aggregate input value into the table. */
+void Insert(AggregationHashTable *aht, int32_t a, const std::string &b, int32_t value) {
+  std::vector<char> key;
+  AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(a), &key);
+  AggregationHashTable::AppendKey(ValueFactory::GetVarcharValue(b), &key);
+  std::vector<Value> input(ALL_AGGREGATES.size(), ValueFactory::GetIntegerValue(value));
+  aht->InsertCombine(key, AggregationHashTable::HashKey(key), input);
+}
+
+/** @return the groups of the table as (a, b) -> {count, sum, min, max} */
+std::map<std::pair<int32_t, std::string>, std::vector<int32_t>> Groups(const AggregationHashTable &aht) {
+  std::map<std::pair<int32_t, std::string>, std::vector<int32_t>> groups;
+  for (size_t group = 0; group < aht.GetNumGroups(); group++) {
+    std::vector<Value> group_bys = aht.GetGroupBys(group);
+    std::vector<int32_t> aggregates;
+    for (const auto &value : aht.GetAggregates(group)) {
+      aggregates.push_back(value.GetAs<int32_t>());
+    }
+    groups[{group_bys[0].GetAs<int32_t>(), group_bys[1].ToString()}] = aggregates;
+  }
+  return groups;
+}
+
+/** Spills a group of one table and merges its records into another. */
+void MergeSpilledGroup(AggregationHashTable *aht, const AggregationHashTable &from, size_t group) {
+  for (const auto &record : from.SpillGroup(group)) {
+    aht->MergeSpilled(record);
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, GroupTest) {
+  AggregationHashTable aht({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  // Enough groups to grow the table several times, each seen three times.
+  const int32_t num_groups = 1000;
+  for (int32_t round = 0; round < 3; round++) {
+    for (int32_t i = 0; i < num_groups; i++) {
+      Insert(&aht, i % 10, std::to_string(i), i + round);
+    }
+  }
+
+  ASSERT_EQ(num_groups, aht.GetNumGroups());
+  auto groups = Groups(aht);
+  for (int32_t i = 0; i < num_groups; i++) {
+    std::vector<int32_t> expected{3, 3 * i + 3, i, i + 2};
+    EXPECT_EQ(expected, (groups[{i % 10, std::to_string(i)}]));
+  }
+
+  aht.Clear();
+  EXPECT_EQ(0, aht.GetNumGroups());
+  Insert(&aht, 1, "a", 5);
+  EXPECT_EQ(1, aht.GetNumGroups());
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, KeyTest) {
+  AggregationHashTable aht({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  // The varchar lengths are part of the key, so shifting bytes between the columns makes different groups.
+  Insert(&aht, 1, "ab", 1);
+  Insert(&aht, 1, "a", 1);
+  Insert(&aht, 1, "", 1);
+  EXPECT_EQ(3, aht.GetNumGroups());
+
+  // All the NULLs of a column are one group.
+  AggregationHashTable nulls({TypeId::INTEGER}, ALL_AGGREGATES);
+  std::vector<Value> input(ALL_AGGREGATES.size(), ValueFactory::GetIntegerValue(1));
+  for (int i = 0; i < 3; i++) {
+    std::vector<char> key;
+    AggregationHashTable::AppendKey(ValueFactory::GetNullValueByType(TypeId::INTEGER), &key);
+    nulls.InsertCombine(key, AggregationHashTable::HashKey(key), input);
+  }
+  ASSERT_EQ(1, nulls.GetNumGroups());
+  EXPECT_TRUE(nulls.GetGroupBys(0)[0].IsNull());
+  EXPECT_EQ(3, nulls.GetAggregates(0)[0].GetAs<int32_t>());
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, MergeTest) {
+  AggregationHashTable left({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  AggregationHashTable right({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  AggregationHashTable expected({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  for (int32_t i = 0; i < 500; i++) {
+    Insert(i % 2 == 0 ? &left : &right, i % 7, std::to_string(i % 13), i);
+    Insert(&expected, i % 7, std::to_string(i % 13), i);
+  }
+
+  // Counts are merged by adding the partial counts, not by counting the partial groups.
+  left.Merge(right);
+  EXPECT_EQ(Groups(expected), Groups(left));
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, SpillTest) {
+  AggregationHashTable aht({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  AggregationHashTable expected({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  for (int32_t i = 0; i < 300; i++) {
+    Insert(&aht, i % 5, std::to_string(i % 11), i);
+    Insert(&expected, i % 5, std::to_string(i % 11), i);
+  }
+  // A spilled group merges with the same group still in memory, and creates the ones that are not.
+  AggregationHashTable restored({TypeId::INTEGER, TypeId::VARCHAR}, ALL_AGGREGATES);
+  for (size_t group = 0; group < aht.GetNumGroups(); group++) {
+    std::vector<Tuple> records = aht.SpillGroup(group);
+    ASSERT_EQ(1, records.size());
+    EXPECT_EQ(aht.GetHash(group), AggregationHashTable::SpilledHash(records[0]));
+    restored.MergeSpilled(records[0]);
+    if (group % 2 == 0) {
+      restored.MergeSpilled(records[0]);
+      expected.MergeGroup(aht, group);
+    }
+  }
+  EXPECT_EQ(Groups(expected), Groups(restored));
+
+  // Sums keep the type they grew into.
+  AggregationHashTable decimals({TypeId::INTEGER}, {AggregationType::SumAggregate});
+  std::vector<char> key;
+  AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(1), &key);
+  decimals.InsertCombine(key, AggregationHashTable::HashKey(key), {ValueFactory::GetDecimalValue(1.5)});
+  AggregationHashTable decimals_restored({TypeId::INTEGER}, {AggregationType::SumAggregate});
+  MergeSpilledGroup(&decimals_restored, decimals, 0);
+  MergeSpilledGroup(&decimals_restored, decimals, 0);
+  Value sum = decimals_restored.GetAggregates(0)[0];
+  EXPECT_EQ(TypeId::DECIMAL, sum.GetTypeId());
+  EXPECT_DOUBLE_EQ(3.0, sum.GetAs<double>());
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, DistinctTest) {
+  const std::vector<AggregationType> agg_types{AggregationType::AvgAggregate, AggregationType::CountDistinctAggregate,
+                                               AggregationType::ApproxCountDistinctAggregate};
+  auto insert = [&agg_types](AggregationHashTable *aht, int32_t group, const Value &value) {
+    std::vector<char> key;
+    AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(group), &key);
+    aht->InsertCombine(key, AggregationHashTable::HashKey(key), std::vector<Value>(agg_types.size(), value));
+  };
+  // Group 0 sees the values 0..9999 twice, group 1 sees 7 once, and group 2 only NULLs.
+  AggregationHashTable left({TypeId::INTEGER}, agg_types);
+  AggregationHashTable right({TypeId::INTEGER}, agg_types);
+  for (int32_t i = 0; i < 20000; i++) {
+    insert(i % 3 == 0 ? &left : &right, 0, ValueFactory::GetIntegerValue(i % 10000));
+  }
+  insert(&right, 1, ValueFactory::GetIntegerValue(7));
+  insert(&left, 2, ValueFactory::GetNullValueByType(TypeId::INTEGER));
+
+  // Merging partials is exact for AVG and COUNT DISTINCT, whether they were in memory or spilled.
+  AggregationHashTable merged({TypeId::INTEGER}, agg_types);
+  merged.Merge(left);
+  for (size_t group = 0; group < right.GetNumGroups(); group++) {
+    MergeSpilledGroup(&merged, right, group);
+  }
+  ASSERT_EQ(3, merged.GetNumGroups());
+  std::map<int32_t, std::vector<Value>> groups;
+  for (size_t group = 0; group < merged.GetNumGroups(); group++) {
+    groups[merged.GetGroupBys(group)[0].GetAs<int32_t>()] = merged.GetAggregates(group);
+  }
+  EXPECT_EQ(TypeId::DECIMAL, groups[0][0].GetTypeId());
+  EXPECT_DOUBLE_EQ(4999.5, groups[0][0].GetAs<double>());
+  EXPECT_EQ(10000, groups[0][1].GetAs<int32_t>());
+  EXPECT_NEAR(10000, groups[0][2].GetAs<int32_t>(), 500);
+  EXPECT_DOUBLE_EQ(7.0, groups[1][0].GetAs<double>());
+  EXPECT_EQ(1, groups[1][1].GetAs<int32_t>());
+  EXPECT_EQ(1, groups[1][2].GetAs<int32_t>());
+  // NULLs are ignored, so the average of no values is NULL.
+  EXPECT_TRUE(groups[2][0].IsNull());
+  EXPECT_EQ(0, groups[2][1].GetAs<int32_t>());
+  EXPECT_EQ(0, groups[2][2].GetAs<int32_t>());
+
+  // Each distinct value and sketch is a record of its own, so none of them outgrows a temporary page however many
+  // values the group has; the group's own record comes last.
+  std::vector<Tuple> records = right.SpillGroup(0);
+  ASSERT_GT(records.size(), 10000);
+  AggregationHashTable restored({TypeId::INTEGER}, agg_types);
+  for (size_t i = 0; i < records.size(); i++) {
+    EXPECT_LE(records[i].GetLength(), TmpTuplePage::MaxTupleSize());
+    EXPECT_EQ(i + 1 == records.size(), restored.MergeSpilled(records[i]));
+  }
+  EXPECT_EQ(10000, restored.GetAggregates(0)[1].GetAs<int32_t>());
+
+  // The distinct values and sketches count towards the memory usage, and are released with the groups.
+  EXPECT_GT(merged.GetMemoryUsage(), 10000 + 3 * HyperLogLog::NUM_REGISTERS);
+  merged.Clear();
+  EXPECT_LT(merged.GetMemoryUsage(), 1000);
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, ResetToGroupTest) {
+  const std::vector<AggregationType> agg_types{AggregationType::SumAggregate, AggregationType::AvgAggregate,
+                                               AggregationType::CountDistinctAggregate,
+                                               AggregationType::ApproxCountDistinctAggregate};
+  AggregationHashTable aht({TypeId::INTEGER}, agg_types);
+  // Each group is combined into group 0 of a table reset for it, as a streaming aggregate does.
+  for (int32_t group = 0; group < 3; group++) {
+    std::vector<char> key;
+    AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(group), &key);
+    aht.ResetToGroup(key, AggregationHashTable::HashKey(key));
+    for (int32_t i = 0; i <= group; i++) {
+      aht.Combine(0, std::vector<Value>(agg_types.size(), ValueFactory::GetIntegerValue(i)));
+    }
+
+    ASSERT_EQ(1, aht.GetNumGroups());
+    EXPECT_EQ(group, aht.GetGroupBys(0)[0].GetAs<int32_t>());
+    std::vector<Value> aggregates = aht.GetAggregates(0);
+    EXPECT_EQ(group * (group + 1) / 2, aggregates[0].GetAs<int32_t>());
+    EXPECT_DOUBLE_EQ(group / 2.0, aggregates[1].GetAs<double>());
+    EXPECT_EQ(group + 1, aggregates[2].GetAs<int32_t>());
+    EXPECT_EQ(group + 1, aggregates[3].GetAs<int32_t>());
+  }
+
+  // The table still finds its one group by key.
+  std::vector<char> key;
+  AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(2), &key);
+  aht.InsertCombine(key, AggregationHashTable::HashKey(key),
+                    std::vector<Value>(agg_types.size(), ValueFactory::GetIntegerValue(3)));
+  EXPECT_EQ(1, aht.GetNumGroups());
+}
+
+// Not a correctness test: compares the table with the map from vectors of Values it replaced.
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, DISABLED_AggregationBenchmark) {
+  const int32_t num_tuples = 2000000;
+  const int32_t num_groups = 100000;
+  auto time_ms = [](auto start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+  std::vector<AggregationType> agg_types{AggregationType::CountAggregate, AggregationType::SumAggregate};
+  std::vector<Value> input{ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(1)};
+
+  auto start = std::chrono::steady_clock::now();
+  std::unordered_map<AggregateKey, AggregateValue> map;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    AggregateKey key{{ValueFactory::GetIntegerValue(i % num_groups), ValueFactory::GetIntegerValue(i % 7)}};
+    auto it = map.find(key);
+    if (it == map.end()) {
+      it = map.insert({key, {{ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(0)}}}).first;
+    }
+    it->second.aggregates_[0] = it->second.aggregates_[0].Add(ValueFactory::GetIntegerValue(1));
+    it->second.aggregates_[1] = it->second.aggregates_[1].Add(input[1]);
+  }
+  LOG_INFO("unordered_map<AggregateKey>: %zu groups in %ld ms", map.size(), time_ms(start));
+
+  start = std::chrono::steady_clock::now();
+  AggregationHashTable aht({TypeId::INTEGER, TypeId::INTEGER}, agg_types);
+  std::vector<char> key;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    key.clear();
+    AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(i % num_groups), &key);
+    AggregationHashTable::AppendKey(ValueFactory::GetIntegerValue(i % 7), &key);
+    aht.InsertCombine(key, AggregationHashTable::HashKey(key), input);
+  }
+  LOG_INFO("AggregationHashTable: %zu groups in %ld ms", aht.GetNumGroups(), time_ms(start));
+
+  EXPECT_EQ(map.size(), aht.GetNumGroups());
+}
+
+}  // namespace bustub
@@ -0,0 +1,198 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_predicate_test.cpp
+//
+// Identification: test/execution/compiled_predicate_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "execution/compiled_predicate.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+const std::vector<ComparisonType> ALL_COMPARISONS = {
+    ComparisonType::Equal,       ComparisonType::NotEqual,           ComparisonType::LessThan,
+    ComparisonType::GreaterThan, ComparisonType::LessThanOrEqual,    ComparisonType::GreaterThanOrEqual};
+
+Schema MakeSchema() {
+  std::vector<Column> columns{Column("tiny", TypeId::TINYINT),    Column("small", TypeId::SMALLINT),
+                              Column("int", TypeId::INTEGER),     Column("big", TypeId::BIGINT),
+                              Column("dec", TypeId::DECIMAL),     Column("str", TypeId::VARCHAR, 16),
+                              Column("int2", TypeId::INTEGER)};
+  return Schema(columns);
+}
+
+/** Rows with small values around the constants under test; every fourth row has NULLs in it. */
+std::vector<Tuple> MakeTuples(const Schema &schema, int num_tuples) {
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    int v = i % 11 - 5;
+    std::vector<Value> values{ValueFactory::GetTinyIntValue(static_cast<int8_t>(v)),
+                              ValueFactory::GetSmallIntValue(static_cast<int16_t>(v)),
+                              ValueFactory::GetIntegerValue(v),
+                              ValueFactory::GetBigIntValue(v),
+                              ValueFactory::GetDecimalValue(v + 0.5),
+                              ValueFactory::GetVarcharValue(std::to_string(v)),
+                              ValueFactory::GetIntegerValue(i % 7 - 3)};
+    if (i % 4 == 3) {
+      uint32_t col = (i / 4) % 5;
+      values[col] = ValueFactory::GetNullValueByType(schema.GetColumn(col).GetType());
+      values[6] = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    }
+    tuples.emplace_back(values, &schema);
+  }
+  return tuples;
+}
+
+/** The reference result: NULL comparisons are false. */
+bool Interpret(const AbstractExpression *predicate, const Tuple &tuple, const Schema &schema) {
+  Value result = predicate->Evaluate(&tuple, &schema);
+  return !result.IsNull() && result.GetAs<bool>();
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(CompiledPredicateTest, ColumnConstantTest) {
+  Schema schema = MakeSchema();
+  std::vector<Tuple> tuples = MakeTuples(schema, 200);
+  std::vector<Value> constants{ValueFactory::GetTinyIntValue(2), ValueFactory::GetIntegerValue(-3),
+                               ValueFactory::GetBigIntValue(0), ValueFactory::GetDecimalValue(1.5),
+                               ValueFactory::GetDecimalValue(-2.25)};
+
+  for (uint32_t col = 0; col < 5; col++) {
+    ColumnValueExpression column(0, col, schema.GetColumn(col).GetType());
+    for (const auto &constant : constants) {
+      ConstantValueExpression constant_expr(constant);
+      for (auto comp_type : ALL_COMPARISONS) {
+        ComparisonExpression column_first(&column, &constant_expr, comp_type);
+        ComparisonExpression constant_first(&constant_expr, &column, comp_type);
+        for (const ComparisonExpression *predicate : {&column_first, &constant_first}) {
+          CompiledPredicate compiled(predicate, &schema);
+          EXPECT_TRUE(compiled.IsCompiled());
+          for (const auto &tuple : tuples) {
+            EXPECT_EQ(Interpret(predicate, tuple, schema), compiled.Evaluate(&tuple))
+                << "column " << col << ", constant " << constant.ToString() << ", comparison "
+                << static_cast<int>(comp_type);
+          }
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(CompiledPredicateTest, ColumnColumnTest) {
+  Schema schema = MakeSchema();
+  std::vector<Tuple> tuples = MakeTuples(schema, 200);
+  ColumnValueExpression int_col(0, 2, TypeId::INTEGER);
+  ColumnValueExpression int2_col(0, 6, TypeId::INTEGER);
+  ColumnValueExpression big_col(0, 3, TypeId::BIGINT);
+
+  for (auto comp_type : ALL_COMPARISONS) {
+    ComparisonExpression same_type(&int_col, &int2_col, comp_type);
+    CompiledPredicate compiled(&same_type, &schema);
+    EXPECT_TRUE(compiled.IsCompiled());
+    for (const auto &tuple : tuples) {
+      EXPECT_EQ(Interpret(&same_type, tuple, schema), compiled.Evaluate(&tuple));
+    }
+
+    // Columns of different types are left to the interpreter.
+    ComparisonExpression mixed_type(&int_col, &big_col, comp_type);
+    CompiledPredicate interpreted(&mixed_type, &schema);
+    EXPECT_FALSE(interpreted.IsCompiled());
+    for (const auto &tuple : tuples) {
+      EXPECT_EQ(Interpret(&mixed_type, tuple, schema), interpreted.Evaluate(&tuple));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(CompiledPredicateTest, FallbackTest) {
+  Schema schema = MakeSchema();
+  std::vector<Tuple> tuples = MakeTuples(schema, 50);
+
+  CompiledPredicate no_predicate(nullptr, &schema);
+  for (const auto &tuple : tuples) {
+    EXPECT_TRUE(no_predicate.Evaluate(&tuple));
+  }
+
+  // Comparing with NULL never holds.
+  ColumnValueExpression int_col(0, 2, TypeId::INTEGER);
+  ConstantValueExpression null_constant(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  ComparisonExpression null_compare(&int_col, &null_constant, ComparisonType::NotEqual);
+  CompiledPredicate compiled_null(&null_compare, &schema);
+  EXPECT_TRUE(compiled_null.IsCompiled());
+  for (const auto &tuple : tuples) {
+    EXPECT_FALSE(compiled_null.Evaluate(&tuple));
+  }
+
+  // VARCHAR columns have no kernel.
+  ColumnValueExpression str_col(0, 5, TypeId::VARCHAR);
+  ConstantValueExpression str_constant(ValueFactory::GetVarcharValue("3"));
+  ComparisonExpression str_compare(&str_col, &str_constant, ComparisonType::Equal);
+  CompiledPredicate interpreted(&str_compare, &schema);
+  EXPECT_FALSE(interpreted.IsCompiled());
+  int matches = 0;
+  for (const auto &tuple : tuples) {
+    EXPECT_EQ(Interpret(&str_compare, tuple, schema), interpreted.Evaluate(&tuple));
+    matches += interpreted.Evaluate(&tuple) ? 1 : 0;
+  }
+  EXPECT_GT(matches, 0);
+}
+
+// Not a correctness test: reports the cost of interpreting a predicate against running its compiled kernel.
+// NOLINTNEXTLINE
+TEST(CompiledPredicateTest, DISABLED_CompiledPredicateBenchmark) {
+  Schema schema = MakeSchema();
+  std::vector<Tuple> tuples = MakeTuples(schema, 100000);
+  ColumnValueExpression int_col(0, 2, TypeId::INTEGER);
+  ConstantValueExpression constant(ValueFactory::GetIntegerValue(1));
+  ComparisonExpression predicate(&int_col, &constant, ComparisonType::LessThan);
+  CompiledPredicate compiled(&predicate, &schema);
+  const int rounds = 50;
+
+  auto time_ms = [](auto start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  size_t interpreted_matches = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (const auto &tuple : tuples) {
+      interpreted_matches += predicate.Evaluate(&tuple, &schema).GetAs<bool>() ? 1 : 0;
+    }
+  }
+  LOG_INFO("interpreted: %ld ms", time_ms(start));
+
+  size_t compiled_matches = 0;
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (const auto &tuple : tuples) {
+      compiled_matches += compiled.Evaluate(&tuple) ? 1 : 0;
+    }
+  }
+  LOG_INFO("compiled: %ld ms", time_ms(start));
+
+  EXPECT_GT(compiled_matches, 0);
+  EXPECT_GE(interpreted_matches, compiled_matches);
+}
+
+}  // namespace bustub
@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// simd_filter_test.cpp
+//
+// Identification: test/execution/simd_filter_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <random>
+#include <vector>
+
+#include "common/logger.h"
+#include "execution/simd_filter.h"
+#include "gtest/gtest.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+const std::vector<ComparisonType> ALL_COMPARISONS = {
+    ComparisonType::Equal,       ComparisonType::NotEqual,        ComparisonType::LessThan,
+    ComparisonType::GreaterThan, ComparisonType::LessThanOrEqual, ComparisonType::GreaterThanOrEqual};
+
+template <typename T>
+bool Holds(T value, ComparisonType comp_type, T constant) {
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return value == constant;
+    case ComparisonType::NotEqual:
+      return value != constant;
+    case ComparisonType::LessThan:
+      return value < constant;
+    case ComparisonType::LessThanOrEqual:
+      return value <= constant;
+    case ComparisonType::GreaterThan:
+      return value > constant;
+    default:
+      return value >= constant;
+  }
+}
+
+/** Filters values of every length up to values.size() with every comparison, checking against a plain loop. */
+template <typename T>
+void CheckFilter(const std::vector<T> &values, T null_value, const std::vector<T> &constants) {
+  std::vector<uint32_t> selection(values.size());
+  for (uint32_t count : {0U, 1U, 3U, 4U, 7U, 8U, 9U, 31U, static_cast<uint32_t>(values.size())}) {
+    for (T constant : constants) {
+      for (auto comp_type : ALL_COMPARISONS) {
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < count; i++) {
+          if (values[i] != null_value && Holds(values[i], comp_type, constant)) {
+            expected.push_back(i);
+          }
+        }
+        uint32_t num_selected = SimdFilter::Filter(values.data(), count, comp_type, constant, selection.data());
+        ASSERT_EQ(expected.size(), num_selected) << "count " << count << ", comparison " << static_cast<int>(comp_type);
+        for (uint32_t i = 0; i < num_selected; i++) {
+          EXPECT_EQ(expected[i], selection[i]);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(SimdFilterTest, IntegerTest) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int32_t> dist(-20, 20);
+  std::vector<int32_t> values(1000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = i % 9 == 4 ? BUSTUB_INT32_NULL : dist(gen);
+  }
+  // The extremes of the domain are next to the NULL sentinel.
+  values[1] = BUSTUB_INT32_MIN;
+  values[2] = BUSTUB_INT32_MAX;
+  CheckFilter<int32_t>(values, BUSTUB_INT32_NULL, {-21, -3, 0, 5, 20, BUSTUB_INT32_MIN, BUSTUB_INT32_MAX});
+}
+
+// NOLINTNEXTLINE
+TEST(SimdFilterTest, BigIntTest) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int64_t> dist(-20, 20);
+  std::vector<int64_t> values(1000);
+  for (size_t i = 0; i < values.size(); i++) {
+    // Values beyond 32 bits make sure all 64 bits take part in the comparison.
+    values[i] = i % 9 == 4 ? BUSTUB_INT64_NULL : dist(gen) * (int64_t{1} << 33);
+  }
+  values[1] = BUSTUB_INT64_MIN;
+  values[2] = BUSTUB_INT64_MAX;
+  CheckFilter<int64_t>(values, BUSTUB_INT64_NULL,
+                       {0, 5 * (int64_t{1} << 33), -(int64_t{1} << 33), 1, BUSTUB_INT64_MIN, BUSTUB_INT64_MAX});
+}
+
+// NOLINTNEXTLINE
+TEST(SimdFilterTest, DecimalTest) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> dist(-40, 40);
+  std::vector<double> values(1000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = i % 9 == 4 ? BUSTUB_DECIMAL_NULL : dist(gen) / 2.0;
+  }
+  values[1] = BUSTUB_DECIMAL_MIN;
+  values[2] = BUSTUB_DECIMAL_MAX;
+  CheckFilter<double>(values, BUSTUB_DECIMAL_NULL, {-20.5, -1, 0, 0.25, 3.5, 20, BUSTUB_DECIMAL_MAX});
+}
+
+// Not a correctness test: reports the cost of a plain loop against the SIMD kernel on a selective filter.
+// NOLINTNEXTLINE
+TEST(SimdFilterTest, DISABLED_FilterBenchmark) {
+  const uint32_t num_values = 1 << 20;
+  const int rounds = 100;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int32_t> dist(0, 999);
+  std::vector<int32_t> values(num_values);
+  for (auto &value : values) {
+    value = dist(gen);
+  }
+  std::vector<uint32_t> selection(num_values);
+
+  auto time_ms = [](auto start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  uint64_t loop_matches = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (uint32_t i = 0; i < num_values; i++) {
+      if (values[i] != BUSTUB_INT32_NULL && values[i] < 10) {
+        selection[loop_matches++ % num_values] = i;
+      }
+    }
+  }
+  LOG_INFO("plain loop, 1%% selectivity: %ld ms", time_ms(start));
+
+  uint64_t simd_matches = 0;
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    simd_matches += SimdFilter::Filter(values.data(), num_values, ComparisonType::LessThan, 10, selection.data());
+  }
+  LOG_INFO("SimdFilter, 1%% selectivity: %ld ms", time_ms(start));
+
+  EXPECT_EQ(loop_matches, simd_matches);
+}
+
+}  // namespace bustub
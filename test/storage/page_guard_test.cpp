@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_guard_test.cpp
+//
+// Identification: test/storage/page_guard_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/page/page_guard.h"
+
+namespace bustub {
+
+// A latched guard cannot be sliced into a plain PageGuard, which would unpin the page without unlatching it.
+static_assert(!std::is_convertible_v<ReadPageGuard &&, PageGuard>);
+static_assert(!std::is_convertible_v<WritePageGuard &&, PageGuard>);
+// A read guard only gives read access to its page.
+static_assert(std::is_same_v<decltype(std::declval<const ReadPageGuard &>().As<Page>()), const Page *>);
+
+// NOLINTNEXTLINE
+TEST(PageGuardTest, DISABLED_SampleTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 5;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+
+  // Scenario: a new page is written through its guard and unpinned when the guard goes out of scope.
+  page_id_t page_id;
+  {
+    auto guard = bpm->NewPageGuarded(&page_id);
+    ASSERT_TRUE(guard.IsValid());
+    snprintf(guard.GetDataMut(), PAGE_SIZE, "Hello");
+  }
+  auto *page = bpm->FetchPage(page_id);
+  EXPECT_EQ(1, page->GetPinCount());
+  bpm->UnpinPage(page_id, false);
+
+  // Scenario: moving a guard hands over its pin; the moved-from guard releases nothing.
+  {
+    auto first = bpm->FetchPageRead(page_id);
+    ReadPageGuard second(std::move(first));
+    EXPECT_FALSE(first.IsValid());  // NOLINT
+    ASSERT_TRUE(second.IsValid());
+    EXPECT_EQ(1, page->GetPinCount());
+    EXPECT_EQ(0, strcmp(second.GetData(), "Hello"));
+    ReadPageGuard third;
+    third = std::move(second);
+    EXPECT_EQ(1, page->GetPinCount());
+    third.Drop();
+    EXPECT_EQ(0, page->GetPinCount());
+  }
+
+  // Scenario: the write was marked dirty, so it survives the page being evicted.
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t other_id;
+    auto other = bpm->NewPageGuarded(&other_id);
+    EXPECT_TRUE(other.IsValid());
+  }
+  {
+    auto guard = bpm->FetchPageWrite(page_id);
+    ASSERT_TRUE(guard.IsValid());
+    EXPECT_EQ(0, strcmp(guard.GetData(), "Hello"));
+  }
+
+  // Scenario: every guard reported how long it held its pin.
+  auto stats = bpm->GetPinStats();
+  EXPECT_EQ(buffer_pool_size + 3, stats.num_pins_);
+  EXPECT_LE(stats.max_, stats.total_);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -12,15 +12,21 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
+#include "common/util/arena.h"
+#include "execution/tuple_batch.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
@@ -71,4 +77,129 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, DISABLED_TupleViewTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::BIGINT};
+  Schema schema{std::vector<Column>{col1, col2}};
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  std::vector<RID> rid_v;
+  std::vector<Tuple> tuple_v;
+  for (int i = 0; i < 1000; ++i) {
+    tuple_v.push_back(ConstructTuple(&schema));
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(tuple_v.back(), &rid, transaction));
+    rid_v.push_back(rid);
+  }
+
+  // A view reads the tuple in place, and a materialized copy outlives it.
+  std::vector<Tuple> materialized;
+  for (size_t i = 0; i < rid_v.size(); ++i) {
+    TupleView view;
+    ASSERT_TRUE(table->GetTupleView(rid_v[i], &view, transaction));
+    EXPECT_FALSE(view.GetTuple().IsAllocated());
+    EXPECT_EQ(rid_v[i].Get(), view.GetRid().Get());
+    EXPECT_EQ(tuple_v[i].GetLength(), view.GetTuple().GetLength());
+    EXPECT_EQ(0, memcmp(tuple_v[i].GetData(), view.GetTuple().GetData(), tuple_v[i].GetLength()));
+    EXPECT_TRUE(view.GetValue(&schema, 1).CompareEquals(tuple_v[i].GetValue(&schema, 1)) == CmpBool::CmpTrue);
+    materialized.push_back(view.Materialize());
+  }
+  for (size_t i = 0; i < rid_v.size(); ++i) {
+    EXPECT_EQ(0, memcmp(tuple_v[i].GetData(), materialized[i].GetData(), tuple_v[i].GetLength()));
+  }
+
+  // Views of one page share its pin and latch, which are released with the last of them: the buffer pool would run
+  // out of frames if they leaked, and deleting would wait on the latch.
+  {
+    TupleView first;
+    TupleView second;
+    ASSERT_TRUE(table->GetTupleView(rid_v[0], &first, transaction));
+    second = first;
+    first.Reset();
+    EXPECT_EQ(0, memcmp(tuple_v[0].GetData(), second.GetTuple().GetData(), tuple_v[0].GetLength()));
+  }
+  for (const auto &rid : rid_v) {
+    EXPECT_TRUE(table->MarkDelete(rid, transaction));
+  }
+  TupleView deleted;
+  EXPECT_FALSE(table->GetTupleView(rid_v[0], &deleted, transaction));
+  EXPECT_FALSE(deleted.IsValid());
+
+  disk_manager->ShutDown();
+  remove("test.db");  // remove db file
+  remove("test.log");
+  delete table;
+  delete buffer_pool_manager;
+  delete log_manager;
+  delete lock_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, ArenaTupleTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::BIGINT};
+  Schema schema{std::vector<Column>{col1, col2}};
+  std::vector<Value> values{ValueFactory::GetVarcharValue("arena"), ValueFactory::GetBigIntValue(42)};
+
+  // A tuple built in an arena matches one built on the heap, but does not own its data.
+  Arena arena;
+  Tuple owned(values, &schema);
+  Tuple tuple(values, &schema, &arena);
+  EXPECT_FALSE(tuple.IsAllocated());
+  ASSERT_EQ(owned.GetLength(), tuple.GetLength());
+  EXPECT_EQ(0, memcmp(owned.GetData(), tuple.GetData(), tuple.GetLength()));
+  EXPECT_EQ(tuple.GetLength(), arena.GetBytesAllocated());
+
+  // Copies share the arena's memory; copying into the arena or materializing copies the data.
+  Tuple shallow = tuple;
+  EXPECT_EQ(tuple.GetData(), shallow.GetData());
+  Tuple copy(owned, &arena);
+  EXPECT_FALSE(copy.IsAllocated());
+  EXPECT_NE(owned.GetData(), copy.GetData());
+  EXPECT_EQ("arena", copy.GetValue(&schema, 0).ToString());
+  Tuple materialized = tuple.Materialize();
+  EXPECT_TRUE(materialized.IsAllocated());
+  EXPECT_NE(tuple.GetData(), materialized.GetData());
+  arena.Reset();
+  EXPECT_EQ("arena", materialized.GetValue(&schema, 0).ToString());
+  EXPECT_EQ(42, materialized.GetValue(&schema, 1).GetAs<int64_t>());
+
+  // Moving hands the data over without copying it.
+  const char *data = materialized.GetData();
+  Tuple moved(std::move(materialized));
+  EXPECT_TRUE(moved.IsAllocated());
+  EXPECT_EQ(data, moved.GetData());
+  EXPECT_EQ(nullptr, materialized.GetData());  // NOLINT
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, BatchArenaTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Schema schema{std::vector<Column>{col1}};
+  std::vector<Value> values{ValueFactory::GetVarcharValue("batch")};
+
+  // The tuples of a batch live in its arena, which moves with the batch and is freed when it is cleared.
+  TupleBatch batch;
+  batch.Append(Tuple(values, &schema, batch.GetArena()), RID());
+  EXPECT_LT(0, batch.GetArena()->GetBytesAllocated());
+  TupleBatch moved(std::move(batch));
+  EXPECT_EQ("batch", moved.GetTuple(0).GetValue(&schema, 0).ToString());
+  moved.Clear();
+  EXPECT_EQ(0, moved.GetArena()->GetBytesAllocated());
+
+  // A moved-from batch can be cleared and reused.
+  batch.Clear();  // NOLINT
+  batch.Append(Tuple(values, &schema, batch.GetArena()), RID());
+  EXPECT_EQ(1, batch.Size());
+}
+
 }  // namespace bustub
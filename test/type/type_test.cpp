@@ -10,13 +10,16 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "common/exception.h"
 #include "gtest/gtest.h"
+#include "type/type_dispatch.h"
 #include "type/value.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 //===--------------------------------------------------------------------===//
@@ -95,4 +98,108 @@ TEST(TypeTests, TemplateTest) {
   BPlusTreePage<Value, Value> node;
   node.GetInfo(val1, val2);
 }
+
+// NOLINTNEXTLINE
+TEST(TypeTests, VarcharInlineTest) {
+  // Short strings are stored in the value itself, long ones on the heap; both behave the same.
+  auto is_inline = [](const Value &val) {
+    auto data = reinterpret_cast<uintptr_t>(val.GetData());
+    auto self = reinterpret_cast<uintptr_t>(&val);
+    return data >= self && data < self + sizeof(Value);
+  };
+  std::string short_str = "short";
+  std::string long_str = "a string that is too long to be inlined";
+  Value short_val(TypeId::VARCHAR, short_str);
+  Value long_val(TypeId::VARCHAR, long_str);
+  EXPECT_TRUE(is_inline(short_val));
+  EXPECT_FALSE(is_inline(long_val));
+
+  // Copies, assignments and swaps keep the data with the value.
+  Value short_copy = short_val;
+  Value long_copy = long_val;
+  EXPECT_TRUE(is_inline(short_copy));
+  EXPECT_EQ(short_str, short_copy.ToString());
+  EXPECT_EQ(long_str, long_copy.ToString());
+  EXPECT_EQ(CmpBool::CmpTrue, short_copy.CompareEquals(short_val));
+  EXPECT_EQ(CmpBool::CmpTrue, short_copy.CompareGreaterThan(long_copy));
+  Swap(short_copy, long_copy);
+  EXPECT_TRUE(is_inline(long_copy));
+  EXPECT_EQ(short_str, long_copy.ToString());
+  EXPECT_EQ(long_str, short_copy.ToString());
+  short_copy = long_copy;
+  EXPECT_EQ(short_str, short_copy.ToString());
+
+  // Serialized values read back the same, and values that do not manage their data are not copied.
+  std::vector<char> storage(sizeof(uint32_t) + long_str.size() + 1);
+  for (const auto &val : {short_val, long_val}) {
+    val.SerializeTo(storage.data());
+    Value restored = Value::DeserializeFrom(storage.data(), TypeId::VARCHAR);
+    EXPECT_EQ(val.ToString(), restored.ToString());
+    EXPECT_EQ(val.GetLength(), restored.GetLength());
+  }
+  Value borrowed(TypeId::VARCHAR, short_str.c_str(), short_str.size() + 1, false);
+  EXPECT_EQ(short_str.c_str(), borrowed.GetData());
+  EXPECT_TRUE(Value(TypeId::VARCHAR, nullptr, 0, false).IsNull());
+}
+
+// NOLINTNEXTLINE
+TEST(TypeTests, TypeDispatchTest) {
+  // The fast paths give the same answers as the virtual Types, including for NULLs and mixed types.
+  std::vector<Value> values{ValueFactory::GetTinyIntValue(3),
+                            ValueFactory::GetSmallIntValue(-7),
+                            ValueFactory::GetIntegerValue(5),
+                            ValueFactory::GetIntegerValue(-5),
+                            ValueFactory::GetIntegerValue(5),
+                            ValueFactory::GetBigIntValue(1LL << 40),
+                            ValueFactory::GetBigIntValue(-3),
+                            ValueFactory::GetDecimalValue(2.5),
+                            ValueFactory::GetDecimalValue(-1.0),
+                            ValueFactory::GetBooleanValue(true),
+                            ValueFactory::GetBooleanValue(false),
+                            ValueFactory::GetNullValueByType(TypeId::INTEGER),
+                            ValueFactory::GetNullValueByType(TypeId::DECIMAL)};
+  auto same = [](const Value &left, const Value &right) {
+    return left.GetTypeId() == right.GetTypeId() &&
+           (left.IsNull() ? right.IsNull() : left.CompareEquals(right) == CmpBool::CmpTrue);
+  };
+  for (const auto &lhs : values) {
+    for (const auto &rhs : values) {
+      if (!lhs.CheckComparable(rhs)) {
+        continue;
+      }
+      EXPECT_EQ(lhs.CompareEquals(rhs), TypeDispatch::CompareEquals(lhs, rhs));
+      EXPECT_EQ(lhs.CompareNotEquals(rhs), TypeDispatch::CompareNotEquals(lhs, rhs));
+      EXPECT_EQ(lhs.CompareLessThan(rhs), TypeDispatch::CompareLessThan(lhs, rhs));
+      EXPECT_EQ(lhs.CompareLessThanEquals(rhs), TypeDispatch::CompareLessThanEquals(lhs, rhs));
+      EXPECT_EQ(lhs.CompareGreaterThan(rhs), TypeDispatch::CompareGreaterThan(lhs, rhs));
+      EXPECT_EQ(lhs.CompareGreaterThanEquals(rhs), TypeDispatch::CompareGreaterThanEquals(lhs, rhs));
+      if (lhs.CheckInteger() || lhs.GetTypeId() == TypeId::DECIMAL) {
+        EXPECT_TRUE(same(lhs.Add(rhs), TypeDispatch::Add(lhs, rhs)));
+        EXPECT_TRUE(same(lhs.Min(rhs), TypeDispatch::Min(lhs, rhs)));
+        EXPECT_TRUE(same(lhs.Max(rhs), TypeDispatch::Max(lhs, rhs)));
+      }
+    }
+  }
+
+  // Overflow is an error on both paths.
+  auto max_int = ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX);
+  EXPECT_THROW(max_int.Add(ValueFactory::GetIntegerValue(1)), Exception);
+  EXPECT_THROW(TypeDispatch::Add(max_int, ValueFactory::GetIntegerValue(1)), Exception);
+
+  // Serialized values compare in place, and NULLs are left to the generic path.
+  char lhs[sizeof(int64_t)];
+  char rhs[sizeof(int64_t)];
+  int cmp = 2;
+  ValueFactory::GetBigIntValue(-3).SerializeTo(lhs);
+  ValueFactory::GetBigIntValue(1LL << 40).SerializeTo(rhs);
+  EXPECT_TRUE(TypeDispatch::CompareSerialized(TypeId::BIGINT, lhs, rhs, &cmp));
+  EXPECT_EQ(-1, cmp);
+  EXPECT_TRUE(TypeDispatch::CompareSerialized(TypeId::BIGINT, rhs, lhs, &cmp));
+  EXPECT_EQ(1, cmp);
+  EXPECT_TRUE(TypeDispatch::CompareSerialized(TypeId::BIGINT, lhs, lhs, &cmp));
+  EXPECT_EQ(0, cmp);
+  ValueFactory::GetNullValueByType(TypeId::BIGINT).SerializeTo(rhs);
+  EXPECT_FALSE(TypeDispatch::CompareSerialized(TypeId::BIGINT, lhs, rhs, &cmp));
+  EXPECT_FALSE(TypeDispatch::CompareSerialized(TypeId::VARCHAR, lhs, rhs, &cmp));
+}
 }  // namespace bustub